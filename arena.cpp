@@ -0,0 +1,63 @@
+#include "lib/arena.h"
+
+using namespace std;
+
+ScratchArena& ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+void ScratchArena::reserve(unsigned long bits) {
+    if (bits <= bits_) return;
+    bits_ = bits;
+    for (mpz_class& x : nums_) {
+        if ((unsigned long)x.get_mpz_t()->_mp_alloc * GMP_NUMB_BITS < 2 * bits_ + 128) {
+            mpz_realloc2(x.get_mpz_t(), 2 * bits_ + 128);
+        }
+    }
+}
+
+mpz_class& ScratchArena::num() {
+    if (top_ == nums_.size()) {
+        nums_.emplace_back();
+        if (bits_ > 0) mpz_realloc2(nums_.back().get_mpz_t(), 2 * bits_ + 128);
+    }
+    return nums_[top_++];
+}
+
+// Blocs de mots : on avance dans le bloc courant, sinon on passe au
+// suivant (remplacé s'il est trop petit : rien au-delà n'est vivant)
+mp_limb_t* ScratchArena::limbs(size_t n) {
+    if (block_ < blocks_.size() && offset_ + n <= blocks_[block_].size()) {
+        mp_limb_t* p = blocks_[block_].data() + offset_;
+        offset_ += n;
+        return p;
+    }
+    if (block_ < blocks_.size() && offset_ > 0) ++block_;
+    size_t want = max<size_t>(n, blocks_.empty() ? 4096 : 2 * blocks_.back().size());
+    if (block_ == blocks_.size()) {
+        blocks_.emplace_back(want);
+    } else if (blocks_[block_].size() < n) {
+        blocks_[block_].assign(want, 0);
+    }
+    offset_ = n;
+    return blocks_[block_].data();
+}
+
+size_t ScratchArena::words() const {
+    size_t total = 0;
+    for (const auto& b : blocks_) total += b.size();
+    return total;
+}
+
+ScratchArena::Frame::Frame(unsigned long bits)
+    : arena_(ScratchArena::local()), top_(arena_.top_),
+      block_(arena_.block_), offset_(arena_.offset_) {
+    if (bits > 0) arena_.reserve(bits);
+}
+
+ScratchArena::Frame::~Frame() {
+    arena_.top_ = top_;
+    arena_.block_ = block_;
+    arena_.offset_ = offset_;
+}
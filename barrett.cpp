@@ -0,0 +1,39 @@
+#include "lib/arena.h"
+#include "lib/barrett.h"
+
+using namespace std;
+
+BarrettContext::BarrettContext(const mpz_class& n) : n_(n) {
+    unsigned long k = (mpz_sizeinbase(n.get_mpz_t(), 2) + 63) / 64;
+    shift_lo_ = 64 * (k - 1);
+    shift_hi_ = 64 * (k + 1);
+    bound_ = mpz_class(1) << (128 * k);
+
+    // Seul calcul coûteux : une division, faite une fois pour toutes
+    mu_ = quotient(bound_, n);
+}
+
+void BarrettContext::reduce(mpz_class& r, const mpz_class& x) const {
+    if (x < 0 || x >= bound_) {
+        r = modulo(x, n_);
+        return;
+    }
+
+    ScratchArena::Frame frame;
+    mpz_class& q = frame.num();
+    mpz_tdiv_q_2exp(q.get_mpz_t(), x.get_mpz_t(), shift_lo_);
+    mpz_mul(q.get_mpz_t(), q.get_mpz_t(), mu_.get_mpz_t());
+    mpz_tdiv_q_2exp(q.get_mpz_t(), q.get_mpz_t(), shift_hi_);    // estimation de x / n
+    mpz_mul(q.get_mpz_t(), q.get_mpz_t(), n_.get_mpz_t());
+    mpz_sub(r.get_mpz_t(), x.get_mpz_t(), q.get_mpz_t());       // q est trop petit d'au plus 2
+
+    if (r >= n_) mpz_sub(r.get_mpz_t(), r.get_mpz_t(), n_.get_mpz_t());
+    if (r >= n_) mpz_sub(r.get_mpz_t(), r.get_mpz_t(), n_.get_mpz_t());
+}
+
+void BarrettContext::mul(mpz_class& r, const mpz_class& a, const mpz_class& b) const {
+    ScratchArena::Frame frame;
+    mpz_class& t = frame.num();
+    mpz_mul(t.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
+    reduce(r, t);
+}
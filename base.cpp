@@ -1,9 +1,21 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "lib/arena.h"
 #include "lib/base.h"
+#include "lib/montgomery.h"
+#include "lib/barrett.h"
+#include "lib/window.h"
+#include "lib/instrument.h"
 
 
 using namespace std;
 
-mpz_class modulo(mpz_class a, mpz_class n) {
+// Les échelles de modulo(), quotient() et division_euclidienne()
+// travaillent sur des entiers de l'arène du thread (arena.h) : aucun
+// temporaire alloué, seul le résultat retourné l'est.
+mpz_class modulo(const mpz_class& a, const mpz_class& n) {
+    RSA_TIMED(modulo);
     // Sécurité : n = 0
     if (n == 0) {
         std::cerr << "Erreur : Modulo par zéro !" << std::endl;
@@ -19,65 +31,73 @@ mpz_class modulo(mpz_class a, mpz_class n) {
     // Cas simple
     if (a < n) return a;
 
-    mpz_class m = n;
-    mpz_class r = a;
+    ScratchArena::Frame frame;
+    mpz_class& m = frame.num();
+    mpz_class& m2 = frame.num();
+    mpz_class& r = frame.num();
+    m = n;
+    r = a;
 
     // --- Phase 1 : Ascension ---
     // On double m jusqu'à atteindre le plus grand multiple <= r
-    while ((m + m) <= r) {
-        m = m + m; // On n'utilise que l'addition
+    for (;;) {
+        mpz_add(m2.get_mpz_t(), m.get_mpz_t(), m.get_mpz_t());   // On n'utilise que l'addition
+        if (m2 > r) break;
+        mpz_swap(m.get_mpz_t(), m2.get_mpz_t());
     }
 
     // --- Phase 2 : Descente ---
     // On réduit r en utilisant les blocs m
     while (m >= n) {
+        RSA_COUNT(modulo_steps);
         if (r >= m) {
-            r = r - m; // On n'utilise que la soustraction
+            mpz_sub(r.get_mpz_t(), r.get_mpz_t(), m.get_mpz_t());   // On n'utilise que la soustraction
         }
         // Division par 2 via décalage binaire (Right Shift)
-        // C'est l'opération de base équivalente à mpz_tdiv_q_2exp
-        m = m/2; // Division par 2 (décalage à droite)
+        mpz_tdiv_q_2exp(m.get_mpz_t(), m.get_mpz_t(), 1);
     }
 
-    // Cas négatif : normaliser dans [0, n)
-    if (r < 0) r = r + n;
-
     return r;
 }
 
+mpz_class modulo(const mpz_class& a, const BarrettContext& ctx) {
+    RSA_TIMED(modulo);
+    return ctx.reduce(a);
+}
 
-mpz_class quotient(mpz_class a, mpz_class n) {
-    // Cas simple : a < n => quotient = 0
-    if (a < n) return 0;
-
-    mpz_class m = n;    // Le bloc multiple de n
-    mpz_class p = 1;    // La puissance de 2 actuelle
-    mpz_class r = a;    // Le reste temporaire
-    mpz_class q = 0;    // Le quotient final
-
-    // Phase d'ascension
-    while ((m + m) <= r) {
-        m = m + m;
-        p = p + p;
-    }
 
-    // Phase de descente
-    while (m >= n) {
-        if (r >= m) {
-            r = r - m;
-            q = q + p;
-        }
-        m = m / 2;
-        p = p / 2;
-    }
-
-    return q;
+mpz_class quotient(const mpz_class& a, const mpz_class& n) {
+    ScratchArena::Frame frame;
+    return division_euclidienne(a, n, frame.num());
 }
 
 
 // Exponentiation Modulaire : Square and Multiply 
 // Calcule (base^exp) mod n 
+// Pour un module impair, tout le calcul se fait dans le domaine de Montgomery :
+// une seule conversion à l'entrée et une à la sortie, REDC entre les deux.
 mpz_class ExpoMod(mpz_class base, mpz_class exp, mpz_class n) {
+    RSA_TIMED(exp);
+    if (n > 1 && (n & 1) == 1) {
+        MontgomeryContext ctx(n);
+        mpz_class result = ctx.one();
+        base = ctx.to_mont(modulo(base, n));
+        while (exp > 0) {
+            if (mpz_odd_p(exp.get_mpz_t())) {
+                ctx.mul(result, result, base);
+                RSA_COUNT(exp_multiplies);
+            }
+            exp = exp >> 1;
+            ctx.mul(base, base, base);
+            RSA_COUNT(exp_squarings);
+        }
+        return ctx.from_mont(result);
+    }
+
+    if (n == 0) return modulo(base, n);
+
+    // Module pair : réduction de Barrett, le contexte sert à toute la boucle
+    BarrettContext bar(n);
     mpz_class result = 1;
     
     // Étape 1 : Réduire la base initiale avec la fonction modulo
@@ -85,13 +105,15 @@ mpz_class ExpoMod(mpz_class base, mpz_class exp, mpz_class n) {
 
     // Étape 2 : Parcourir les bits de l'exposant
     while (exp > 0) {
-        if ((exp & 1) == 1) {  // Si le bit de poids faible est à 1 (c'est-à-dire si exp est impair)
-              result = modulo(result * base, n); // On multiplie le résultat par la base courante, puis on réduit
+        if (mpz_odd_p(exp.get_mpz_t())) {  // Si le bit de poids faible est à 1 (c'est-à-dire si exp est impair)
+              bar.mul(result, result, base); // On multiplie le résultat par la base courante, puis on réduit
+              RSA_COUNT(exp_multiplies);
         }
         // On décale l'exposant d'un bit vers la droite (équivaut à diviser par 2)
         exp = exp >> 1; 
         // On élève la base au carré pour le prochain bit, puis on réduit
-        base = modulo(base * base, n); 
+        bar.mul(base, base, base);
+        RSA_COUNT(exp_squarings);
     }
     return result;
 }
@@ -99,121 +121,195 @@ mpz_class ExpoMod(mpz_class base, mpz_class exp, mpz_class n) {
 
 // Exponentiation Modulaire : Fenêtres Glissantes (Sliding Window)
 // Calcule (base^exp) mod n de manière très optimisée
+// Module impair : domaine de Montgomery ; module pair : réduction de Barrett.
 mpz_class mod_exp_window(mpz_class base, mpz_class exp, mpz_class n) {
+    RSA_TIMED(exp);
     if (exp == 0) return 1;
 
-    // Paramètre : Taille maximale de la fenêtre (4 bits est optimal pour RSA)
-    int w = 4; 
-    
-    // Le tableau stockera 2^(w-1) = 8 valeurs (uniquement les puissances impaires)
-    int num_precomp = 1 << (w - 1); 
-    std::vector<mpz_class> g(num_precomp);
-
-    //  1. PHASE DE PRÉCALCUL
-    // On précalcule base^1, base^3, base^5, ..., base^15
-    g[0] = modulo(base, n);                   // base^1
-    mpz_class base2 = modulo(base * base, n); // base^2 (sert à sauter de 2 en 2)
-    
-    for (int j = 1; j < num_precomp; j++) {
-        g[j] = modulo(g[j - 1] * base2, n);
+    if (n > 1 && (n & 1) == 1) {
+        MontgomeryContext ctx(n);
+        return ctx.exp(base, exp);
     }
 
-    //  2. CALCUL DU NOMBRE DE BITS DE L'EXPOSANT
-    // Totalement "artisanal" pour respecter vos contraintes (sans fonction GMP)
-    int total_bits = 0;
-    mpz_class temp_exp = exp;
-    while (temp_exp > 0) {
-        total_bits++;
-        temp_exp = temp_exp >> 1;
+    if (n == 0) return modulo(base, n);
+
+    BarrettContext bar(n);
+    mpz_class r;
+    sliding_window(r, modulo(base, n), exp, mpz_class(1),
+        [&bar](mpz_class& x, const mpz_class& a, const mpz_class& b) { bar.mul(x, a, b); });
+    return r;
+}
+
+
+// Multi-exponentiation : fenêtres entrelacées (apply_multi) dans le
+// domaine de Montgomery, ou avec Barrett pour un module pair
+mpz_class mod_multi_exp(const vector<mpz_class>& bases, const vector<mpz_class>& exps,
+                        const mpz_class& n) {
+    RSA_TIMED(exp);
+    if (bases.size() != exps.size()) throw runtime_error("mod_multi_exp: tailles différentes");
+    for (const auto& e : exps) {
+        if (e < 0) throw runtime_error("mod_multi_exp: exposant négatif");
     }
 
-    //  3. PHASE D'ÉVALUATION (Lecture de gauche à droite)
-    mpz_class result = 1;
-    int i = total_bits - 1;
+    if (n > 1 && (n & 1) == 1) {
+        MontgomeryContext ctx(n);
+        return ctx.multi_exp(bases, exps);
+    }
+    if (n <= 1) return 0;
+
+    BarrettContext bar(n);
+    vector<mpz_class> g1(bases.size());
+    for (size_t i = 0; i < bases.size(); ++i) g1[i] = modulo(bases[i], n);
+    mpz_class r;
+    apply_multi(r, g1, exps, modulo(mpz_class(1), n),
+        [&bar](mpz_class& x, const mpz_class& a, const mpz_class& b) { bar.mul(x, a, b); });
+    return r;
+}
 
-    while (i >= 0) {
-        // On lit le bit à la position i
-        int bit_i = ((exp >> i) & 1) == 1 ? 1 : 0;
 
-        if (bit_i == 0) {
-            // Si le bit est 0, on fait juste une élévation au carré
-            result = modulo(result * result, n);
-            i--;
-        } else {
-            // Si le bit est 1, on cherche à grouper les bits dans une "fenêtre"
-            // l est l'index de fin de la fenêtre (au maximum w bits plus loin)
-            int l = std::max(0, i - w + 1);
-            
-            // Une fenêtre glissante DOIT se terminer par un bit à 1 (être impair)
-            while ( (((exp >> l) & 1) == 1 ? 1 : 0) == 0 ) {
-                l++; 
-            }
+// Exponentiation à temps constant pour les exposants secrets : voir
+// MontgomeryContext::exp_consttime. Un module pair n'a pas de domaine de
+// Montgomery : on retombe alors sur la fenêtre glissante.
+mpz_class mod_exp_consttime(const mpz_class& base, const mpz_class& exp, const mpz_class& n) {
+    if (n > 1 && (n & 1) == 1) {
+        MontgomeryContext ctx(n);
+        return ctx.exp_consttime(base, exp);
+    }
+    return mod_exp_window(base, exp, n);
+}
 
-            // On extrait la valeur entière contenue dans cette fenêtre binaire
-            int window_value = 0;
-            for (int j = i; j >= l; j--) {
-                int bit_j = ((exp >> j) & 1) == 1 ? 1 : 0;
-                window_value = (window_value << 1) + bit_j;
-            }
 
-            // On applique autant de carrés que la taille de la fenêtre qu'on vient de lire
-            for (int j = 0; j < (i - l + 1); j++) {
-                result = modulo(result * result, n);
-            }
+// Exposant fixe 65537 = 2^16 + 1 : chaîne d'addition codée en dur
+// (16 élévations au carré puis une multiplication par la base)
+mpz_class mod_exp_65537(const mpz_class& base, const mpz_class& n) {
+    if (n > 1 && (n & 1) == 1) {
+        MontgomeryContext ctx(n);
+        return ctx.exp_65537(base);
+    }
+    if (n == 0) return modulo(base, n);
+
+    BarrettContext bar(n);
+    mpz_class g1 = modulo(base, n);
+    mpz_class r = g1;
+    for (int i = 0; i < 16; ++i) bar.mul(r, r, r);
+    bar.mul(r, r, g1);
+    return r;
+}
+
 
-            // On multiplie par la valeur précalculée correspondante !
-            // (Comme on n'a stocké que les impairs, l'indice est window_value / 2)
-            result = modulo(result * g[window_value / 2], n);
+// ============================================================
+// Conversions octets <-> entier
+//   Le premier octet est le poids fort (même convention qu'avant).
+//   On lit et on écrit 8 octets à la fois : le mot i de l'entier couvre
+//   les octets [len - 8(i+1), len - 8i) du tampon.
+// ============================================================
+static inline uint64_t load_be64(const std::byte* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
 
-            // On recule notre pointeur de lecture pour la suite
-            i = l - 1;
+static inline void store_be64(std::byte* p, uint64_t v) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    memcpy(p, &v, 8);
+}
+
+void bytesToNum(mpz_class& num, const std::byte* data, std::size_t len) {
+    size_t nl = (len + 7) / 8;
+    if (nl == 0) {
+        num = 0;
+        return;
+    }
+    mp_limb_t* w = mpz_limbs_write(num.get_mpz_t(), nl);
+    size_t end = len;
+    for (size_t i = 0; i < nl; ++i, end -= 8) {
+        if (end >= 8) {
+            w[i] = load_be64(data + end - 8);
+        } else {
+            // Mot de poids fort incomplet
+            uint64_t v = 0;
+            for (size_t j = 0; j < end; ++j) v = (v << 8) | static_cast<uint8_t>(data[j]);
+            w[i] = v;
+            break;
         }
     }
+    mpz_limbs_finish(num.get_mpz_t(), nl);
+}
 
-    return result;
+bool numToBytesFixed(std::byte* out, std::size_t len, const mpz_class& num) {
+    if (num < 0) return false;
+    size_t need = (num == 0) ? 0 : (mpz_sizeinbase(num.get_mpz_t(), 2) + 7) / 8;
+    if (need > len) return false;
+
+    const mp_limb_t* w = mpz_limbs_read(num.get_mpz_t());
+    size_t nl = mpz_size(num.get_mpz_t());
+    size_t end = len;
+    for (size_t i = 0; i < nl; ++i) {
+        if (end >= 8) {
+            store_be64(out + end - 8, w[i]);
+            end -= 8;
+        } else {
+            // Dernier mot à cheval sur le début du tampon : ses octets
+            // de poids fort sont nuls puisque need <= len
+            uint64_t v = w[i];
+            for (size_t j = end; j-- > 0; v >>= 8) out[j] = static_cast<std::byte>(v & 0xFF);
+            end = 0;
+        }
+    }
+    memset(out, 0, end);   // zéros à gauche
+    return true;
 }
 
+std::size_t numToBytes(std::byte* out, std::size_t cap, const mpz_class& num) {
+    size_t need = (num <= 0) ? 0 : (mpz_sizeinbase(num.get_mpz_t(), 2) + 7) / 8;
+    if (need <= cap) numToBytesFixed(out, need, num);
+    return need;
+}
 
 void stringToNum(mpz_class& num, const string& str) {
-    num = 0;
-    for (char c : str) {
-        num = (num << 8) + static_cast<unsigned char>(c);
-    }
+    bytesToNum(num, reinterpret_cast<const std::byte*>(str.data()), str.size());
 }
 void numToString(string& str, const mpz_class& num) {
-    mpz_class temp = num;
-    str.clear();
-    while (temp > 0) {
-        char c = static_cast<char>(temp.get_ui() & 0xFF);
-        str = c + str;
-        temp = temp >> 8;
-    }
+    size_t need = numToBytes(nullptr, 0, num);
+    str.resize(need);
+    if (need > 0) numToBytes(reinterpret_cast<std::byte*>(&str[0]), need, num);
 }
 
-mpz_class division_euclidienne(mpz_class a, mpz_class n, mpz_class &r) {
+mpz_class division_euclidienne(const mpz_class& a, const mpz_class& n, mpz_class &r) {
     if (n == 0) return 0;
     if (a < n) { r = a; return 0; }
 
-    r = a;           
-    mpz_class q = 0; 
-    mpz_class m = n; 
-    mpz_class p = 1; 
-
-    while ((m + m) <= r) {
-        m = m + m; 
-        p = p + p; 
+    ScratchArena::Frame frame;
+    mpz_class& rr = frame.num();   // r peut être a ou n : copié à la fin
+    mpz_class& q = frame.num();
+    mpz_class& m = frame.num();
+    mpz_class& m2 = frame.num();
+    mpz_class& p = frame.num();
+    rr = a;
+    q = 0;
+    m = n;
+    p = 1;
+
+    for (;;) {
+        mpz_add(m2.get_mpz_t(), m.get_mpz_t(), m.get_mpz_t());
+        if (m2 > rr) break;
+        mpz_swap(m.get_mpz_t(), m2.get_mpz_t());
+        mpz_add(p.get_mpz_t(), p.get_mpz_t(), p.get_mpz_t());
     }
 
     while (m >= n) {
-        if (r >= m) {
-            r = r - m; 
-            q = q + p;
+        if (rr >= m) {
+            mpz_sub(rr.get_mpz_t(), rr.get_mpz_t(), m.get_mpz_t());
+            mpz_add(q.get_mpz_t(), q.get_mpz_t(), p.get_mpz_t());
         }
-        m = m / 2; 
-        p = p / 2; 
+        mpz_tdiv_q_2exp(m.get_mpz_t(), m.get_mpz_t(), 1);
+        mpz_tdiv_q_2exp(p.get_mpz_t(), p.get_mpz_t(), 1);
     }
-    return q; 
+    r = rr;
+    return q;
 }
-
-
-
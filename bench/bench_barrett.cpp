@@ -0,0 +1,59 @@
+// Banc d'essai : réduction de Barrett contre l'échelle de modulo()
+//
+//   cmake --build build --target bench_barrett
+//
+// Pour chaque taille, on réduit des produits a*b (a, b < n), c'est-à-dire
+// exactement le travail fait après chaque multiplication d'une exponentiation.
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/barrett.h"
+
+using namespace std;
+
+template <typename F>
+static double ns_per_op(F f, size_t ops) {
+    auto t0 = chrono::steady_clock::now();
+    f();
+    auto t1 = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(t1 - t0).count() / ops;
+}
+
+int main() {
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(1234);
+
+    const size_t samples = 256;
+    const int rounds = 8;
+
+    printf("%6s %16s %16s %10s\n", "bits", "modulo (ns)", "barrett (ns)", "speedup");
+    for (unsigned long bits : {1024ul, 2048ul, 4096ul}) {
+        mpz_class n = rng.get_z_bits(bits);
+        mpz_setbit(n.get_mpz_t(), bits - 1);
+
+        vector<mpz_class> x(samples);
+        for (auto& v : x) {
+            mpz_class a = rng.get_z_bits(bits), b = rng.get_z_bits(bits);
+            v = (a % n) * (b % n);
+        }
+
+        BarrettContext ctx(n);
+        mpz_class sink = 0;
+
+        double t_ladder = ns_per_op([&] {
+            for (int r = 0; r < rounds; ++r)
+                for (const auto& v : x) sink += modulo(v, n);
+        }, samples * rounds);
+
+        double t_barrett = ns_per_op([&] {
+            for (int r = 0; r < rounds; ++r)
+                for (const auto& v : x) sink += ctx.reduce(v);
+        }, samples * rounds);
+
+        printf("%6lu %16.0f %16.0f %9.1fx\n", bits, t_ladder, t_barrett, t_ladder / t_barrett);
+        if (sink == -1) puts("");   // empêche l'élimination des boucles
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Banc d'essai : noyau de multiplication de bench/mul.h (réglage des seuils)
+//
+//   cmake --build build --target bench_mul
+//
+// Pour chaque taille n (en mots de 64 bits), temps d'un produit n x n et
+// d'un carré par chaque algorithme pris pour un seul niveau (les
+// sous-produits suivent les seuils courants), puis par mpn_mul_n / mpn_sqr
+// de GMP pour référence. Le seuil d'un algorithme est la première taille
+// où il bat le précédent de façon stable.
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <gmp.h>
+#include "bench/mul.h"
+
+using namespace std;
+
+template <typename F>
+static double ns_per_op(F f) {
+    // Nombre d'itérations ajusté pour ~20 ms de mesure ; meilleur de 3
+    size_t iters = 1;
+    for (;;) {
+        auto t0 = chrono::steady_clock::now();
+        for (size_t i = 0; i < iters; ++i) f();
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count();
+        if (ns > 2e7) break;
+        iters *= 2;
+    }
+    double best = 1e30;
+    for (int r = 0; r < 3; ++r) {
+        auto t0 = chrono::steady_clock::now();
+        for (size_t i = 0; i < iters; ++i) f();
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count();
+        if (ns < best) best = ns;
+    }
+    return best / iters;
+}
+
+int main() {
+    mt19937_64 rng(1234);
+
+    printf("%5s | %9s %9s %9s %9s | %9s %9s %9s %9s\n", "mots",
+           "mul base", "karatsuba", "toom3", "gmp",
+           "sqr base", "karatsuba", "toom3", "gmp");
+    for (size_t n : {8, 12, 16, 20, 24, 28, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192}) {
+        vector<uint64_t> a(n), b(n), r(2 * n), scratch(limb_mul_scratch(n));
+        for (size_t i = 0; i < n; ++i) { a[i] = rng(); b[i] = rng(); }
+        mp_limb_t* gr = (mp_limb_t*)r.data();
+        const mp_limb_t* ga = (const mp_limb_t*)a.data();
+        const mp_limb_t* gb = (const mp_limb_t*)b.data();
+
+        double mb = ns_per_op([&] { limb_mul_basecase(r.data(), a.data(), n, b.data(), n); });
+        double mk = ns_per_op([&] { limb_mul_karatsuba(r.data(), a.data(), b.data(), n, scratch.data()); });
+        double mt = ns_per_op([&] { limb_mul_toom3(r.data(), a.data(), b.data(), n, scratch.data()); });
+        double mg = ns_per_op([&] { mpn_mul_n(gr, ga, gb, n); });
+        double sb = ns_per_op([&] { limb_sqr_basecase(r.data(), a.data(), n); });
+        double sk = ns_per_op([&] { limb_sqr_karatsuba(r.data(), a.data(), n, scratch.data()); });
+        double st = ns_per_op([&] { limb_sqr_toom3(r.data(), a.data(), n, scratch.data()); });
+        double sg = ns_per_op([&] { mpn_sqr(gr, ga, n); });
+
+        printf("%5zu | %9.0f %9.0f %9.0f %9.0f | %9.0f %9.0f %9.0f %9.0f\n",
+               n, mb, mk, mt, mg, sb, sk, st, sg);
+    }
+    return 0;
+}
@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "bench/mul.h"
+
+using namespace std;
+
+using u128 = unsigned __int128;
+
+// ============================================================
+// Primitives sur mots
+// ============================================================
+
+// r = a + b sur n mots, retourne la retenue
+static uint64_t add_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128 s = (u128)a[i] + b[i] + c;
+        r[i] = (uint64_t)s;
+        c = (uint64_t)(s >> 64);
+    }
+    return c;
+}
+
+// r = a - b sur n mots, retourne l'emprunt
+static uint64_t sub_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128 d = (u128)a[i] - b[i] - c;
+        r[i] = (uint64_t)d;
+        c = (uint64_t)(d >> 64) & 1;
+    }
+    return c;
+}
+
+// x[0 .. n) += y[0 .. m), m <= n, retenue propagée ; retourne la retenue sortante
+static uint64_t add_into(uint64_t* x, size_t n, const uint64_t* y, size_t m) {
+    uint64_t c = add_n(x, x, y, m);
+    for (size_t i = m; c && i < n; ++i) c = (++x[i] == 0);
+    return c;
+}
+
+// x[0 .. n) -= y[0 .. m), m <= n ; retourne l'emprunt sortant
+static uint64_t sub_into(uint64_t* x, size_t n, const uint64_t* y, size_t m) {
+    uint64_t c = sub_n(x, x, y, m);
+    for (size_t i = m; c && i < n; ++i) c = (x[i]-- == 0);
+    return c;
+}
+
+// r += a * b (a sur n mots), retourne le mot de retenue
+static uint64_t addmul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) {
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128 t = (u128)a[i] * b + r[i] + c;
+        r[i] = (uint64_t)t;
+        c = (uint64_t)(t >> 64);
+    }
+    return c;
+}
+
+// r = a * b (a sur n mots), retourne le mot de poids fort
+static uint64_t mul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) {
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128 t = (u128)a[i] * b + c;
+        r[i] = (uint64_t)t;
+        c = (uint64_t)(t >> 64);
+    }
+    return c;
+}
+
+// Compare a (n mots) et b (m mots, m <= n, complété par des zéros)
+static int cmp_ext(const uint64_t* a, size_t n, const uint64_t* b, size_t m) {
+    for (size_t i = n; i-- > m;) {
+        if (a[i] != 0) return 1;
+    }
+    for (size_t i = m; i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// r (n mots) = |a - b|, a sur n mots, b sur m <= n mots ; true si a < b
+static bool abs_diff(uint64_t* r, const uint64_t* a, size_t n, const uint64_t* b, size_t m) {
+    if (cmp_ext(a, n, b, m) >= 0) {
+        memcpy(r, a, n * sizeof(uint64_t));
+        sub_into(r, n, b, m);
+        return false;
+    }
+    // b > a : les mots a[m .. n) sont nuls
+    sub_n(r, b, a, m);
+    memset(r + m, 0, (n - m) * sizeof(uint64_t));
+    return true;
+}
+
+// ============================================================
+// Cas de base
+// ============================================================
+void limb_mul_basecase(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+    r[an] = mul_1(r, a, an, b[0]);
+    for (size_t i = 1; i < bn; ++i) r[an + i] = addmul_1(r + i, a, an, b[i]);
+}
+
+void limb_sqr_basecase(uint64_t* r, const uint64_t* a, size_t n) {
+    // Produits croisés a[i]*a[j], i < j, une seule fois
+    memset(r, 0, 2 * n * sizeof(uint64_t));
+    for (size_t i = 0; i + 1 < n; ++i) {
+        r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+    // Doublement (décalage d'un bit) puis ajout de la diagonale a[i]^2
+    uint64_t top = 0;
+    for (size_t i = 0; i < 2 * n; ++i) {
+        uint64_t v = r[i];
+        r[i] = (v << 1) | top;
+        top = v >> 63;
+    }
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        u128 sq = (u128)a[i] * a[i];
+        u128 s = (u128)r[2 * i] + (uint64_t)sq + c;
+        r[2 * i] = (uint64_t)s;
+        s = (u128)r[2 * i + 1] + (uint64_t)(sq >> 64) + (uint64_t)(s >> 64);
+        r[2 * i + 1] = (uint64_t)s;
+        c = (uint64_t)(s >> 64);
+    }
+}
+
+// ============================================================
+// Karatsuba (variante soustractive)
+//   a = a0 + a1 X, b = b0 + b1 X, X = 2^(64h), h = ceil(n/2)
+//   a*b = z0 + (z0 + z2 - (a0-a1)(b0-b1)) X + z2 X^2
+// ============================================================
+void limb_mul_karatsuba(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, uint64_t* s) {
+    size_t h = n - n / 2, m = n / 2;
+    uint64_t* da = s;                 // h
+    uint64_t* db = s + h;             // h
+    uint64_t* z1 = s + 2 * h;         // 2h
+    uint64_t* next = s + 4 * h;
+
+    bool neg = abs_diff(da, a, h, a + h, m) != abs_diff(db, b, h, b + h, m);
+
+    limb_mul_n(r, a, b, h, next);                  // z0 -> r[0 .. 2h)
+    limb_mul_n(r + 2 * h, a + h, b + h, m, next);  // z2 -> r[2h .. 2n)
+    limb_mul_n(z1, da, db, h, next);
+
+    // Milieu t = z0 + z2 -/+ |z1| sur 2h+1 mots (valeur finale >= 0),
+    // dans la zone de travail des appels récursifs, libre désormais
+    uint64_t* t = next;
+    memcpy(t, r, 2 * h * sizeof(uint64_t));
+    t[2 * h] = 0;
+    add_into(t, 2 * h + 1, r + 2 * h, 2 * m);
+    if (neg) add_into(t, 2 * h + 1, z1, 2 * h);
+    else sub_into(t, 2 * h + 1, z1, 2 * h);
+
+    add_into(r + h, 2 * n - h, t, min(2 * h + 1, 2 * n - h));
+}
+
+void limb_sqr_karatsuba(uint64_t* r, const uint64_t* a, size_t n, uint64_t* s) {
+    size_t h = n - n / 2, m = n / 2;
+    uint64_t* da = s;                 // h
+    uint64_t* z1 = s + h;             // 2h
+    uint64_t* next = s + 3 * h;
+
+    abs_diff(da, a, h, a + h, m);
+    limb_sqr_n(r, a, h, next);
+    limb_sqr_n(r + 2 * h, a + h, m, next);
+    limb_sqr_n(z1, da, h, next);
+
+    // Milieu : z0 + z2 - z1 >= 0
+    uint64_t* t = next;
+    memcpy(t, r, 2 * h * sizeof(uint64_t));
+    t[2 * h] = 0;
+    add_into(t, 2 * h + 1, r + 2 * h, 2 * m);
+    sub_into(t, 2 * h + 1, z1, 2 * h);
+
+    add_into(r + h, 2 * n - h, t, min(2 * h + 1, 2 * n - h));
+}
+
+// ============================================================
+// Toom-3 (Bodrato) : a = a0 + a1 X + a2 X^2, X = 2^(64k), k = ceil(n/3)
+//   points 0, 1, -1, 2, infini puis interpolation
+//     r3 = (v2 - vm1) / 3        r1 = (v1 - vm1) / 2     r2 = v1 - v0
+//     r3 = (r3 - r2) / 2 - 2 vinf
+//     r2 = r2 - r1 - vinf        r1 = r1 - r3
+//   Tous les résultats intermédiaires sont >= 0 ; seul vm1 est signé et
+//   il est manipulé en complément à deux sur L = 2k + 2 mots.
+// ============================================================
+
+// Division exacte par 3 sur n mots (multiplication par 3^(-1) mod 2^64)
+static void divexact_by3(uint64_t* r, const uint64_t* a, size_t n) {
+    const uint64_t inv3 = 0xAAAAAAAAAAAAAAABull;
+    uint64_t c = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t s = a[i];
+        uint64_t l = s - c;
+        c = l > s;
+        uint64_t q = l * inv3;
+        r[i] = q;
+        c += (uint64_t)(((u128)q * 3) >> 64);
+    }
+}
+
+static void shr1(uint64_t* r, size_t n) {
+    for (size_t i = 0; i + 1 < n; ++i) r[i] = (r[i] >> 1) | (r[i + 1] << 63);
+    r[n - 1] >>= 1;
+}
+
+static void negate_n(uint64_t* r, size_t n) {
+    uint64_t c = 1;
+    for (size_t i = 0; i < n; ++i) {
+        u128 t = (u128)(~r[i]) + c;
+        r[i] = (uint64_t)t;
+        c = (uint64_t)(t >> 64);
+    }
+}
+
+// Évaluations en 1, -1 et 2 sur k+1 mots ; retourne true si a(-1) < 0
+static bool toom3_eval(uint64_t* e1, uint64_t* em1, uint64_t* e2,
+                       const uint64_t* a, size_t k, size_t s) {
+    const uint64_t* a0 = a;
+    const uint64_t* a1 = a + k;
+    const uint64_t* a2 = a + 2 * k;
+
+    // t = a0 + a2 (dans e1), puis a(1) = t + a1, a(-1) = t - a1
+    memcpy(e1, a0, k * sizeof(uint64_t));
+    e1[k] = add_into(e1, k, a2, s);
+    bool neg = abs_diff(em1, e1, k + 1, a1, k);
+    e1[k] += add_into(e1, k, a1, k);
+
+    // a(2) = a0 + 2 (a1 + 2 a2)
+    memcpy(e2, a1, k * sizeof(uint64_t));
+    e2[k] = add_into(e2, k, a2, s);
+    e2[k] += add_into(e2, k, a2, s);
+    uint64_t top = 0;
+    for (size_t i = 0; i <= k; ++i) {
+        uint64_t v = e2[i];
+        e2[i] = (v << 1) | top;
+        top = v >> 63;
+    }
+    add_into(e2, k + 1, a0, k);
+    return neg;
+}
+
+static void toom3_interpolate(uint64_t* r, size_t n, size_t k, size_t s,
+                              uint64_t* v1, uint64_t* vm1, uint64_t* v2, bool vm1_neg) {
+    const size_t L = 2 * k + 2;
+    const uint64_t* v0 = r;               // 2k mots
+    const uint64_t* vinf = r + 4 * k;     // 2s mots
+    if (vm1_neg) negate_n(vm1, L);
+
+    // r3 = (v2 - vm1) / 3  (dans v2)
+    sub_n(v2, v2, vm1, L);
+    divexact_by3(v2, v2, L);
+    // r1 = (v1 - vm1) / 2  (dans vm1)
+    sub_n(vm1, v1, vm1, L);
+    shr1(vm1, L);
+    // r2 = v1 - v0  (dans v1)
+    sub_into(v1, L, v0, 2 * k);
+    // r3 = (r3 - r2) / 2 - 2 vinf
+    sub_n(v2, v2, v1, L);
+    shr1(v2, L);
+    sub_into(v2, L, vinf, 2 * s);
+    sub_into(v2, L, vinf, 2 * s);
+    // r2 = r2 - r1 - vinf
+    sub_n(v1, v1, vm1, L);
+    sub_into(v1, L, vinf, 2 * s);
+    // r1 = r1 - r3
+    sub_n(vm1, vm1, v2, L);
+
+    // Recomposition : r = v0 + r1 X + r2 X^2 + r3 X^3 + vinf X^4
+    memset(r + 2 * k, 0, 2 * k * sizeof(uint64_t));
+    auto add_at = [&](size_t off, const uint64_t* c) {
+        size_t len = min(L, 2 * n - off);
+        add_into(r + off, 2 * n - off, c, len);
+    };
+    add_at(k, vm1);
+    add_at(2 * k, v1);
+    add_at(3 * k, v2);
+}
+
+void limb_mul_toom3(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, uint64_t* sc) {
+    size_t k = (n + 2) / 3, s = n - 2 * k, L = 2 * k + 2;
+    uint64_t* ea1 = sc;              uint64_t* eam1 = ea1 + k + 1;  uint64_t* ea2 = eam1 + k + 1;
+    uint64_t* eb1 = ea2 + k + 1;     uint64_t* ebm1 = eb1 + k + 1;  uint64_t* eb2 = ebm1 + k + 1;
+    uint64_t* v1 = eb2 + k + 1;      uint64_t* vm1 = v1 + L;        uint64_t* v2 = vm1 + L;
+    uint64_t* next = v2 + L;
+
+    bool neg = toom3_eval(ea1, eam1, ea2, a, k, s) != toom3_eval(eb1, ebm1, eb2, b, k, s);
+
+    limb_mul_n(r, a, b, k, next);                          // v0
+    limb_mul_n(r + 4 * k, a + 2 * k, b + 2 * k, s, next);  // vinf
+    limb_mul_n(v1, ea1, eb1, k + 1, next);
+    limb_mul_n(vm1, eam1, ebm1, k + 1, next);
+    limb_mul_n(v2, ea2, eb2, k + 1, next);
+
+    toom3_interpolate(r, n, k, s, v1, vm1, v2, neg);
+}
+
+void limb_sqr_toom3(uint64_t* r, const uint64_t* a, size_t n, uint64_t* sc) {
+    size_t k = (n + 2) / 3, s = n - 2 * k, L = 2 * k + 2;
+    uint64_t* ea1 = sc;              uint64_t* eam1 = ea1 + k + 1;  uint64_t* ea2 = eam1 + k + 1;
+    uint64_t* v1 = ea2 + k + 1;      uint64_t* vm1 = v1 + L;        uint64_t* v2 = vm1 + L;
+    uint64_t* next = v2 + L;
+
+    toom3_eval(ea1, eam1, ea2, a, k, s);
+
+    limb_sqr_n(r, a, k, next);
+    limb_sqr_n(r + 4 * k, a + 2 * k, s, next);
+    limb_sqr_n(v1, ea1, k + 1, next);
+    limb_sqr_n(vm1, eam1, k + 1, next);
+    limb_sqr_n(v2, ea2, k + 1, next);
+
+    toom3_interpolate(r, n, k, s, v1, vm1, v2, false);
+}
+
+// ============================================================
+// Aiguillage selon la taille
+// ============================================================
+void limb_mul_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, uint64_t* scratch) {
+    if (n < MUL_KARATSUBA_THRESHOLD) limb_mul_basecase(r, a, n, b, n);
+    else if (n < MUL_TOOM3_THRESHOLD) limb_mul_karatsuba(r, a, b, n, scratch);
+    else limb_mul_toom3(r, a, b, n, scratch);
+}
+
+void limb_sqr_n(uint64_t* r, const uint64_t* a, size_t n, uint64_t* scratch) {
+    if (n < SQR_KARATSUBA_THRESHOLD) limb_sqr_basecase(r, a, n);
+    else if (n < SQR_TOOM3_THRESHOLD) limb_sqr_karatsuba(r, a, n, scratch);
+    else limb_sqr_toom3(r, a, n, scratch);
+}
+
+static uint64_t* thread_scratch(size_t n) {
+    thread_local vector<uint64_t> buf;
+    if (buf.size() < limb_mul_scratch(n)) buf.resize(limb_mul_scratch(n));
+    return buf.data();
+}
+
+void limb_mul(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) {
+    if (n < MUL_KARATSUBA_THRESHOLD) limb_mul_basecase(r, a, n, b, n);
+    else limb_mul_n(r, a, b, n, thread_scratch(n));
+}
+
+void limb_sqr(uint64_t* r, const uint64_t* a, size_t n) {
+    if (n < SQR_KARATSUBA_THRESHOLD) limb_sqr_basecase(r, a, n);
+    else limb_sqr_n(r, a, n, thread_scratch(n));
+}
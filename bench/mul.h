@@ -0,0 +1,56 @@
+#ifndef MUL_H
+#define MUL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================
+// Multiplication de grands entiers sur des tableaux de mots de 64 bits
+// (mot de poids faible en premier), uniquement par opérations sur mots :
+//   - cas de base scolaire (n^2 produits de mots)
+//   - carré dédié : les produits croisés a[i]*a[j] (i < j) ne sont
+//     calculés qu'une fois puis doublés, soit n(n-1)/2 + n produits
+//   - Karatsuba (3 produits de taille n/2) à partir de *_KARATSUBA_THRESHOLD
+//   - Toom-3 (5 produits de taille n/3, interpolation de Bodrato) à partir
+//     de *_TOOM3_THRESHOLD
+// Seuils réglés par bench/bench_mul.cpp (x86-64, g++ -O2).
+// Le résultat r (2n mots) ne doit chevaucher aucune opérande.
+// Hors de la bibliothèque : aux tailles des facteurs RSA (8 à 32 mots),
+// mpn_mul_n / mpn_sqr de GMP restent plus rapides (voir lib/uint.h) ;
+// le noyau ne sert qu'à bench_mul et aux tests.
+// ============================================================
+
+constexpr std::size_t MUL_KARATSUBA_THRESHOLD = 24;
+constexpr std::size_t MUL_TOOM3_THRESHOLD = 128;
+constexpr std::size_t SQR_KARATSUBA_THRESHOLD = 48;
+constexpr std::size_t SQR_TOOM3_THRESHOLD = 160;
+
+// r[0 .. an+bn) = a * b, an >= 1, bn >= 1
+void limb_mul_basecase(uint64_t* r, const uint64_t* a, std::size_t an,
+                       const uint64_t* b, std::size_t bn);
+// r[0 .. 2n) = a^2
+void limb_sqr_basecase(uint64_t* r, const uint64_t* a, std::size_t n);
+
+// Mots de travail nécessaires à limb_mul_n / limb_sqr_n pour n mots
+constexpr std::size_t limb_mul_scratch(std::size_t n) { return 8 * n + 64; }
+
+// r[0 .. 2n) = a * b (resp. a^2), algorithme choisi selon n ;
+// scratch : au moins limb_mul_scratch(n) mots
+void limb_mul_n(uint64_t* r, const uint64_t* a, const uint64_t* b, std::size_t n,
+                uint64_t* scratch);
+void limb_sqr_n(uint64_t* r, const uint64_t* a, std::size_t n, uint64_t* scratch);
+
+// Un seul niveau de Karatsuba (n >= 2) ou de Toom-3 (n >= 5), les
+// sous-produits repassant par limb_mul_n / limb_sqr_n (réglage des seuils)
+void limb_mul_karatsuba(uint64_t* r, const uint64_t* a, const uint64_t* b, std::size_t n,
+                        uint64_t* scratch);
+void limb_sqr_karatsuba(uint64_t* r, const uint64_t* a, std::size_t n, uint64_t* scratch);
+void limb_mul_toom3(uint64_t* r, const uint64_t* a, const uint64_t* b, std::size_t n,
+                    uint64_t* scratch);
+void limb_sqr_toom3(uint64_t* r, const uint64_t* a, std::size_t n, uint64_t* scratch);
+
+// Mêmes calculs, mots de travail fournis par un tampon du thread appelant
+void limb_mul(uint64_t* r, const uint64_t* a, const uint64_t* b, std::size_t n);
+void limb_sqr(uint64_t* r, const uint64_t* a, std::size_t n);
+
+#endif  // MUL_H
@@ -0,0 +1,101 @@
+#include <random>
+#include <vector>
+#include "lib/base.h"
+#include "lib/op_mod.h"
+#include "lib/blinding.h"
+
+using namespace std;
+
+BlindingPool::BlindingPool(const RsaPublicKey& pub, size_t capacity, const mpz_class& seed)
+    : pub_(pub), bn_(pub.n()), capacity_(capacity > 0 ? capacity : 1) {
+    // seed = 0 : 256 bits de la source du système. Une graine prévisible
+    // (l'horloge) permettrait de recalculer les r et annulerait l'aveuglement.
+    mpz_class s = seed;
+    if (seed == 0) {
+        random_device rd;
+        for (int i = 0; i < 8; ++i) s = (s << 32) | rd();
+    }
+    worker_ = thread([this, s] { refill_loop(s); });
+}
+
+BlindingPool::~BlindingPool() {
+    {
+        lock_guard<mutex> lk(m_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+mpz_class BlindingPool::mul(const mpz_class& a, const mpz_class& b) const {
+    return mulmod(a, b, bn_);
+}
+
+size_t BlindingPool::available() const {
+    lock_guard<mutex> lk(m_);
+    return pairs_.size();
+}
+
+void BlindingPool::take(mpz_class& re, mpz_class& rinv) {
+    unique_lock<mutex> lk(m_);
+    if (!pairs_.empty()) {
+        last_ = move(pairs_.front());
+        pairs_.pop_front();
+        has_last_ = true;
+        if (pairs_.size() <= capacity_ / 2) cv_.notify_all();   // seuil bas
+    } else if (has_last_) {
+        // Réserve vide : rafraîchissement par carré, sans inversion
+        last_.first = mul(last_.first, last_.first);
+        last_.second = mul(last_.second, last_.second);
+    } else {
+        // Tout premier appel avant la première recharge : on attend
+        cv_.notify_all();
+        cv_.wait(lk, [this] { return !pairs_.empty(); });
+        last_ = move(pairs_.front());
+        pairs_.pop_front();
+        has_last_ = true;
+    }
+    re = last_.first;
+    rinv = last_.second;
+}
+
+void BlindingPool::refill_loop(const mpz_class& seed) {
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(seed);
+    const mpz_class& n = pub_.n();
+
+    vector<mpz_class> r, inv;
+    while (true) {
+        size_t missing;
+        {
+            unique_lock<mutex> lk(m_);
+            cv_.wait(lk, [this] { return stop_ || pairs_.size() <= capacity_ / 2; });
+            if (stop_) return;
+            missing = capacity_ - pairs_.size();
+        }
+
+        // Hors verrou : tirages, une inversion pour tout le lot, r^e
+        r.resize(missing);
+        for (auto& x : r) {
+            do {
+                x = rng.get_z_range(n);
+            } while (x < 2);
+        }
+        long bad;
+        while ((bad = invmod_batch(inv, r, n)) >= 0) {
+            r.erase(r.begin() + bad);   // r partage un facteur avec n (négligeable)
+            if (r.empty()) break;
+        }
+        if (r.empty()) continue;
+
+        vector<pair<mpz_class, mpz_class>> fresh;
+        fresh.reserve(r.size());
+        for (size_t i = 0; i < r.size(); ++i) fresh.emplace_back(pub_.pow(r[i]), inv[i]);
+
+        {
+            lock_guard<mutex> lk(m_);
+            for (auto& p : fresh) pairs_.push_back(move(p));
+        }
+        cv_.notify_all();
+    }
+}
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstring>
+#include "lib/chacha20.h"
+
+using namespace std;
+
+// Lectures / écritures little-endian (indépendantes de l'alignement)
+static inline uint32_t load_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline uint64_t load_le64(const uint8_t* p) {
+    return (uint64_t)load_le32(p) | (uint64_t)load_le32(p + 4) << 32;
+}
+
+static inline void store_le32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void store_le64(uint8_t* p, uint64_t v) {
+    store_le32(p, (uint32_t)v);
+    store_le32(p + 4, (uint32_t)(v >> 32));
+}
+
+static inline const uint8_t* u8(const std::byte* p) { return reinterpret_cast<const uint8_t*>(p); }
+
+// ============================================================
+// ChaCha20
+// ============================================================
+
+static inline uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+#define QR(a, b, c, d)                         \
+    a += b; d ^= a; d = rotl(d, 16);           \
+    c += d; b ^= c; b = rotl(b, 12);           \
+    a += b; d ^= a; d = rotl(d, 8);            \
+    c += d; b ^= c; b = rotl(b, 7);
+
+ChaCha20::ChaCha20(const std::byte key[32], const std::byte nonce[12], uint32_t counter) {
+    state_[0] = 0x61707865; state_[1] = 0x3320646e;   // "expand 32-byte k"
+    state_[2] = 0x79622d32; state_[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i) state_[4 + i] = load_le32(u8(key) + 4 * i);
+    state_[12] = counter;
+    for (int i = 0; i < 3; ++i) state_[13 + i] = load_le32(u8(nonce) + 4 * i);
+}
+
+void ChaCha20::block(uint8_t out[64], const uint32_t state[16]) {
+    uint32_t x[16];
+    memcpy(x, state, sizeof(x));
+    for (int i = 0; i < 10; ++i) {
+        QR(x[0], x[4], x[8],  x[12]);
+        QR(x[1], x[5], x[9],  x[13]);
+        QR(x[2], x[6], x[10], x[14]);
+        QR(x[3], x[7], x[11], x[15]);
+        QR(x[0], x[5], x[10], x[15]);
+        QR(x[1], x[6], x[11], x[12]);
+        QR(x[2], x[7], x[8],  x[13]);
+        QR(x[3], x[4], x[9],  x[14]);
+    }
+    for (int i = 0; i < 16; ++i) store_le32(out + 4 * i, x[i] + state[i]);
+}
+
+#undef QR
+
+void ChaCha20::apply(std::byte* out, const std::byte* in, size_t len) {
+    uint8_t* o = reinterpret_cast<uint8_t*>(out);
+    const uint8_t* p = u8(in);
+
+    // Fin du bloc entamé par l'appel précédent
+    while (len > 0 && used_ < 64) {
+        *o++ = *p++ ^ ks_[used_++];
+        --len;
+    }
+    // Blocs complets : XOR par mots de 64 bits
+    while (len >= 64) {
+        block(ks_, state_);
+        ++state_[12];
+        for (int i = 0; i < 64; i += 8) {
+            uint64_t a, k;
+            memcpy(&a, p + i, 8);
+            memcpy(&k, ks_ + i, 8);
+            a ^= k;
+            memcpy(o + i, &a, 8);
+        }
+        o += 64; p += 64; len -= 64;
+    }
+    if (len > 0) {
+        block(ks_, state_);
+        ++state_[12];
+        for (used_ = 0; used_ < len; ++used_) o[used_] = p[used_] ^ ks_[used_];
+    }
+}
+
+// ============================================================
+// Poly1305 — accumulateur sur 3 mots de 44/44/42 bits, produits
+// sur 128 bits (variante 64 bits de poly1305-donna)
+// ============================================================
+static const uint64_t M44 = 0xfffffffffff, M42 = 0x3ffffffffff;
+
+Poly1305::Poly1305(const std::byte key[32]) {
+    uint64_t t0 = load_le64(u8(key)), t1 = load_le64(u8(key) + 8);
+    // r est « clampé » (RFC 8439, §2.5)
+    r_[0] = t0 & 0xffc0fffffff;
+    r_[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffff;
+    r_[2] = (t1 >> 24) & 0x00ffffffc0f;
+    h_[0] = h_[1] = h_[2] = 0;
+    pad_[0] = load_le64(u8(key) + 16);
+    pad_[1] = load_le64(u8(key) + 24);
+}
+
+void Poly1305::blocks(const uint8_t* m, size_t len, uint64_t hibit) {
+    using u128 = unsigned __int128;
+    const uint64_t r0 = r_[0], r1 = r_[1], r2 = r_[2];
+    const uint64_t s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+    uint64_t h0 = h_[0], h1 = h_[1], h2 = h_[2];
+
+    for (; len >= 16; m += 16, len -= 16) {
+        uint64_t t0 = load_le64(m), t1 = load_le64(m + 8);
+        h0 += t0 & M44;
+        h1 += ((t0 >> 44) | (t1 << 20)) & M44;
+        h2 += ((t1 >> 24) & M42) | hibit;
+
+        u128 d0 = (u128)h0 * r0 + (u128)h1 * s2 + (u128)h2 * s1;
+        u128 d1 = (u128)h0 * r1 + (u128)h1 * r0 + (u128)h2 * s2;
+        u128 d2 = (u128)h0 * r2 + (u128)h1 * r1 + (u128)h2 * r0;
+
+        uint64_t c = (uint64_t)(d0 >> 44); h0 = (uint64_t)d0 & M44;
+        d1 += c; c = (uint64_t)(d1 >> 44); h1 = (uint64_t)d1 & M44;
+        d2 += c; c = (uint64_t)(d2 >> 42); h2 = (uint64_t)d2 & M42;
+        h0 += c * 5; c = h0 >> 44; h0 &= M44;
+        h1 += c;
+    }
+    h_[0] = h0; h_[1] = h1; h_[2] = h2;
+}
+
+void Poly1305::update(const std::byte* data, size_t len) {
+    const uint8_t* m = u8(data);
+    if (buffered_ > 0) {
+        size_t take = min<size_t>(16 - buffered_, len);
+        memcpy(buf_ + buffered_, m, take);
+        buffered_ += take; m += take; len -= take;
+        if (buffered_ < 16) return;
+        blocks(buf_, 16, 1ull << 40);
+        buffered_ = 0;
+    }
+    size_t full = len & ~(size_t)15;
+    blocks(m, full, 1ull << 40);
+    m += full; len -= full;
+    memcpy(buf_, m, len);
+    buffered_ = (unsigned)len;
+}
+
+void Poly1305::pad16() {
+    if (buffered_ == 0) return;
+    memset(buf_ + buffered_, 0, 16 - buffered_);
+    blocks(buf_, 16, 1ull << 40);
+    buffered_ = 0;
+}
+
+void Poly1305::finish(std::byte tag[16]) {
+    // Dernier bloc incomplet : 0x01 puis des zéros, sans bit 2^128
+    if (buffered_ > 0) {
+        buf_[buffered_] = 1;
+        memset(buf_ + buffered_ + 1, 0, 15 - buffered_);
+        blocks(buf_, 16, 0);
+        buffered_ = 0;
+    }
+
+    uint64_t h0 = h_[0], h1 = h_[1], h2 = h_[2], c;
+    c = h1 >> 44; h1 &= M44; h2 += c;
+    c = h2 >> 42; h2 &= M42; h0 += c * 5;
+    c = h0 >> 44; h0 &= M44; h1 += c;
+    c = h1 >> 44; h1 &= M44; h2 += c;
+    c = h2 >> 42; h2 &= M42; h0 += c * 5;
+    c = h0 >> 44; h0 &= M44; h1 += c;
+
+    // g = h + 5 - 2^130 ; on garde g si h >= p = 2^130 - 5 (sans branchement)
+    uint64_t g0 = h0 + 5; c = g0 >> 44; g0 &= M44;
+    uint64_t g1 = h1 + c; c = g1 >> 44; g1 &= M44;
+    uint64_t g2 = h2 + c - (1ull << 42);
+    uint64_t mask = (g2 >> 63) - 1;
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
+
+    // tag = (h + s) mod 2^128
+    uint64_t t0 = pad_[0], t1 = pad_[1];
+    h0 += t0 & M44; c = h0 >> 44; h0 &= M44;
+    h1 += (((t0 >> 44) | (t1 << 20)) & M44) + c; c = h1 >> 44; h1 &= M44;
+    h2 += ((t1 >> 24) & M42) + c; h2 &= M42;
+
+    uint8_t* out = reinterpret_cast<uint8_t*>(tag);
+    store_le64(out, h0 | (h1 << 44));
+    store_le64(out + 8, (h1 >> 20) | (h2 << 24));
+}
+
+// ============================================================
+// ChaCha20-Poly1305 (RFC 8439, §2.8)
+//   clé de Poly1305 = premier bloc de flot (compteur 0),
+//   chiffrement à partir du compteur 1
+// ============================================================
+static void aead_tag(std::byte tag[16], const std::byte key[32], const std::byte nonce[12],
+                     const std::byte* aad, size_t aad_len, const std::byte* ct, size_t len) {
+    std::byte otk[32] = {};
+    ChaCha20(key, nonce, 0).apply(otk, otk, 32);
+
+    Poly1305 mac(otk);
+    mac.update(aad, aad_len);
+    mac.pad16();
+    mac.update(ct, len);
+    mac.pad16();
+    uint8_t lens[16];
+    store_le64(lens, aad_len);
+    store_le64(lens + 8, len);
+    mac.update(reinterpret_cast<const std::byte*>(lens), 16);
+    mac.finish(tag);
+}
+
+void aead_seal(std::byte* out, std::byte tag[16],
+               const std::byte key[32], const std::byte nonce[12],
+               const std::byte* aad, size_t aad_len,
+               const std::byte* in, size_t len) {
+    ChaCha20(key, nonce, 1).apply(out, in, len);
+    aead_tag(tag, key, nonce, aad, aad_len, out, len);
+}
+
+bool aead_open(std::byte* out, const std::byte tag[16],
+               const std::byte key[32], const std::byte nonce[12],
+               const std::byte* aad, size_t aad_len,
+               const std::byte* in, size_t len) {
+    std::byte expected[16];
+    aead_tag(expected, key, nonce, aad, aad_len, in, len);
+
+    // Comparaison à temps constant
+    uint8_t diff = 0;
+    for (int i = 0; i < 16; ++i) diff |= u8(expected)[i] ^ u8(tag)[i];
+    if (diff != 0) return false;
+
+    ChaCha20(key, nonce, 1).apply(out, in, len);
+    return true;
+}
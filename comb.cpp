@@ -0,0 +1,57 @@
+#include "lib/comb.h"
+
+using namespace std;
+
+FixedBaseComb::FixedBaseComb(const mpz_class& n, const mpz_class& base,
+                             unsigned long max_bits, int h, int v)
+    : ctx_(n), base_(base), L_(max_bits), h_(h), v_(v) {
+    a_ = (L_ + h_ - 1) / h_;
+    b_ = (a_ + v_ - 1) / v_;
+
+    // g^(2^(i*a)) pour chaque ligne i
+    vector<mpz_class> rows(h_);
+    rows[0] = ctx_.enter(base);
+    for (int i = 1; i < h_; ++i) {
+        rows[i] = rows[i - 1];
+        for (unsigned long k = 0; k < a_; ++k) rows[i] = ctx_.mul(rows[i], rows[i]);
+    }
+
+    // Bloc 0 : produits de lignes, en ajoutant le bit de poids fort de s
+    size_t width = size_t(1) << h_;
+    table_.assign(width * v_, ctx_.one());
+    for (size_t s = 1; s < width; ++s) {
+        int top = 63 - __builtin_clzll(s);
+        table_[s] = ctx_.mul(table_[s ^ (size_t(1) << top)], rows[top]);
+    }
+
+    // Bloc t : bloc t-1 élevé à la puissance 2^b
+    for (int t = 1; t < v_; ++t) {
+        for (size_t s = 1; s < width; ++s) {
+            mpz_class x = table_[(t - 1) * width + s];
+            for (unsigned long k = 0; k < b_; ++k) x = ctx_.mul(x, x);
+            table_[t * width + s] = x;
+        }
+    }
+}
+
+mpz_class FixedBaseComb::exp(const mpz_class& e) const {
+    if (e < 0 || mpz_sizeinbase(e.get_mpz_t(), 2) > L_) return ctx_.exp(base_, e);
+
+    size_t width = size_t(1) << h_;
+    mpz_class r = ctx_.one();
+    for (unsigned long j = b_; j-- > 0;) {
+        r = ctx_.mul(r, r);
+        for (int t = v_ - 1; t >= 0; --t) {
+            unsigned long col = t * b_ + j;   // position dans la ligne
+            if (col >= a_) continue;
+
+            size_t s = 0;
+            for (int i = h_ - 1; i >= 0; --i) {
+                unsigned long k = i * a_ + col;
+                s = (s << 1) | (k < L_ && mpz_tstbit(e.get_mpz_t(), k) ? 1 : 0);
+            }
+            if (s != 0) r = ctx_.mul(r, table_[t * width + s]);
+        }
+    }
+    return ctx_.from_mont(r);
+}
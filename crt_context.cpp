@@ -0,0 +1,137 @@
+#include <future>
+#include "lib/arena.h"
+#include "lib/crt_context.h"
+#include "lib/uint.h"
+
+using namespace std;
+
+// ============================================================
+// Moitiés sur UInt<B> : une instance par taille déployée, choisie
+// à la construction selon le nombre de mots de p et q
+// ============================================================
+struct CrtContext::FixedHalves {
+    virtual ~FixedHalves() = default;
+    // m = x^d mod p (side 0) ou mod q (side 1), x < p (resp. q)
+    virtual void exp(mpz_class& m, const mpz_class& x, const ExpPlan& plan, int side) const = 0;
+};
+
+namespace {
+
+template <size_t B>
+struct FixedHalvesOf : CrtContext::FixedHalves {
+    FixedHalvesOf(const mpz_class& p, const mpz_class& q)
+        : ctx{UIntMontgomery<B>(uint_from_mpz<B>(p)), UIntMontgomery<B>(uint_from_mpz<B>(q))} {}
+
+    void exp(mpz_class& m, const mpz_class& x, const ExpPlan& plan, int side) const override {
+        uint_to_mpz(m, ctx[side].exp(uint_from_mpz<B>(x), plan));
+    }
+
+    UIntMontgomery<B> ctx[2];
+};
+
+shared_ptr<const CrtContext::FixedHalves> make_fixed(const mpz_class& p, const mpz_class& q) {
+    size_t limbs = mpz_size(p.get_mpz_t());
+    if (mpz_size(q.get_mpz_t()) != limbs) return nullptr;
+    switch (limbs) {
+        case 8:  return make_shared<const FixedHalvesOf<512>>(p, q);
+        case 16: return make_shared<const FixedHalvesOf<1024>>(p, q);
+        case 24: return make_shared<const FixedHalvesOf<1536>>(p, q);
+        case 32: return make_shared<const FixedHalvesOf<2048>>(p, q);
+        default: return nullptr;
+    }
+}
+
+}  // namespace
+
+CrtContext::CrtContext(const mpz_class& p, const mpz_class& q, const mpz_class& qinv)
+    : mp_(p), mq_(q), bp_(p), p_(p), q_(q), qinv_m_(mp_.to_mont(qinv)), fixed_(make_fixed(p, q)) {
+    LaneModulus lp(p), lq(q);
+    if (lp.limbs() == lq.limbs()) lanes_ = make_shared<const MontLanes>(vector<const LaneModulus*>{&lp, &lq});
+}
+
+bool CrtContext::lanes() const {
+    // Aux tailles de UInt, deux exponentiations UInt l'une après l'autre
+    // vont plus vite que les deux voies (bench_suite : exp_half/*, crt_pow)
+    return !fixed_ && lanes_ && MontLanes::profitable(mpz_sizeinbase(p_.get_mpz_t(), 2), 2);
+}
+
+// m = x^d mod p (side 0) ou mod q (side 1), x quelconque
+void CrtContext::half(mpz_class& m, const mpz_class& x, const ExpPlan& plan, int side) const {
+    if (!fixed_) {
+        (side ? mq_ : mp_).exp(m, x, plan);
+        return;
+    }
+    ScratchArena::Frame frame;
+    mpz_class& xr = frame.num();
+    mpz_mod(xr.get_mpz_t(), x.get_mpz_t(), (side ? q_ : p_).get_mpz_t());
+    fixed_->exp(m, xr, plan, side);
+}
+
+void CrtContext::pow(mpz_class& r, const mpz_class& x, const mpz_class& dp,
+                     const mpz_class& dq) const {
+    if (!lanes()) {
+        pow(r, x, window_plan(dp), window_plan(dq));
+        return;
+    }
+
+    // Voies : bases déjà réduites (repliements REDC d'enter, puis sortie)
+    ScratchArena::Frame frame(mp_.bits());
+    mpz_class& xp = frame.num();
+    mpz_class& xq = frame.num();
+    mpz_class& m1 = frame.num();
+    mpz_class& m2 = frame.num();
+    mp_.enter(xp, x);
+    mp_.redc(xp, xp);
+    mq_.enter(xq, x);
+    mq_.redc(xq, xq);
+    const mpz_class* bases[2] = {&xp, &xq};
+    const mpz_class* exps[2] = {&dp, &dq};
+    mpz_class* out[2] = {&m1, &m2};
+    lanes_->exp(out, bases, exps);
+    combine(r, m1, m2);
+}
+
+void CrtContext::pow(mpz_class& r, const mpz_class& x, const ExpPlan& dp, const ExpPlan& dq,
+                     bool parallel) const {
+    ScratchArena::Frame frame(mp_.bits());
+    mpz_class& m1 = frame.num();
+    mpz_class& m2 = frame.num();
+    if (!parallel) {
+        half(m1, x, dp, 0);
+        half(m2, x, dq, 1);
+    } else {
+        // Le second thread prend ses temporaires dans sa propre arène
+        future<void> half_p = async(launch::async, [&] { half(m1, x, dp, 0); });
+        half(m2, x, dq, 1);
+        half_p.get();
+    }
+    combine(r, m1, m2);
+}
+
+void CrtContext::pow_consttime(mpz_class& r, const mpz_class& x, const mpz_class& dp,
+                               const mpz_class& dq, bool parallel) const {
+    ScratchArena::Frame frame(mp_.bits());
+    mpz_class& m1 = frame.num();
+    mpz_class& m2 = frame.num();
+    if (!parallel) {
+        mp_.exp_consttime(m1, x, dp);
+        mq_.exp_consttime(m2, x, dq);
+    } else {
+        future<void> half_p = async(launch::async, [&] { mp_.exp_consttime(m1, x, dp); });
+        mq_.exp_consttime(m2, x, dq);
+        half_p.get();
+    }
+    combine(r, m1, m2);
+}
+
+// Garner : m = m2 + q * (qinv * (m1 - m2) mod p)
+void CrtContext::combine(mpz_class& r, const mpz_class& m1, const mpz_class& m2) const {
+    ScratchArena::Frame frame;
+    mpz_class& h = frame.num();
+    bp_.reduce(h, m2);
+    mpz_sub(h.get_mpz_t(), m1.get_mpz_t(), h.get_mpz_t());
+    if (h < 0) mpz_add(h.get_mpz_t(), h.get_mpz_t(), p_.get_mpz_t());
+    mp_.mul(h, qinv_m_, h);
+    mpz_mul(h.get_mpz_t(), h.get_mpz_t(), q_.get_mpz_t());
+    mpz_add(r.get_mpz_t(), m2.get_mpz_t(), h.get_mpz_t());
+}
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include "lib/instrument.h"
+
+using namespace std;
+
+InstrumentSnapshot& InstrumentSnapshot::operator+=(const InstrumentSnapshot& o) {
+#define RSA_INSTRUMENT_FIELD(name, desc) name += o.name;
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+    return *this;
+}
+
+InstrumentSnapshot InstrumentSnapshot::operator-(const InstrumentSnapshot& o) const {
+    InstrumentSnapshot r;
+#define RSA_INSTRUMENT_FIELD(name, desc) r.name = name - o.name;
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+    return r;
+}
+
+string instrument_dump(const InstrumentSnapshot& s) {
+    ostringstream out;
+#define RSA_INSTRUMENT_FIELD(name, desc) out << #name << " " << s.name << "  # " << desc << "\n";
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+    return out.str();
+}
+
+#ifdef RSA_INSTRUMENT
+
+// Registre des compteurs de tous les threads ; les totaux des threads
+// terminés sont cumulés dans 'retired'. Jamais détruit : des threads
+// peuvent encore se terminer pendant la destruction des statiques.
+namespace {
+struct Registry {
+    mutex m;
+    vector<InstrumentCounters*> live;
+    InstrumentSnapshot retired;
+};
+
+Registry& registry() {
+    static Registry* r = new Registry;
+    return *r;
+}
+
+InstrumentSnapshot read(const InstrumentCounters& c) {
+    InstrumentSnapshot s;
+#define RSA_INSTRUMENT_FIELD(name, desc) s.name = c.name.load(memory_order_relaxed);
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+    return s;
+}
+}  // namespace
+
+InstrumentCounters::InstrumentCounters() {
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    r.live.push_back(this);
+}
+
+InstrumentCounters::~InstrumentCounters() {
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    r.retired += read(*this);
+    r.live.erase(find(r.live.begin(), r.live.end(), this));
+}
+
+bool instrument_enabled() { return true; }
+
+InstrumentSnapshot instrument_snapshot() { return read(instrument_local()); }
+
+InstrumentSnapshot instrument_snapshot_all() {
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    InstrumentSnapshot s = r.retired;
+    for (const InstrumentCounters* c : r.live) s += read(*c);
+    return s;
+}
+
+void instrument_reset() {
+    InstrumentCounters& c = instrument_local();
+    // Les compteurs remis à zéro ne doivent pas disparaître des totaux
+    // du processus : on les reporte dans 'retired'
+    Registry& r = registry();
+    lock_guard<mutex> lk(r.m);
+    r.retired += read(c);
+#define RSA_INSTRUMENT_FIELD(name, desc) c.name.store(0, memory_order_relaxed);
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+}
+
+#else
+
+bool instrument_enabled() { return false; }
+InstrumentSnapshot instrument_snapshot() { return {}; }
+InstrumentSnapshot instrument_snapshot_all() { return {}; }
+void instrument_reset() {}
+
+#endif  // RSA_INSTRUMENT
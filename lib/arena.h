@@ -0,0 +1,68 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <gmpxx.h>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+// ============================================================
+// Arène de travail par thread pour les temporaires de l'arithmétique
+//   - entiers (mpz_class) et tableaux de mots, pris en pile et rendus
+//     en bloc à la sortie d'une portée (Frame)
+//   - rien n'est libéré : un entier rendu garde ses mots, et le même
+//     appel sur un module de même taille retrouve les mêmes entiers, déjà
+//     assez grands. En régime établi, plus aucun appel à malloc.
+//   - une arène par thread (thread_local) : ni verrou ni partage entre
+//     coeurs, pas de contention sur l'allocateur
+// Les entiers d'une portée ne survivent pas à celle-ci : un résultat
+// doit être copié (ou échangé, mpz_swap) vers l'objet de l'appelant.
+// ============================================================
+class ScratchArena {
+public:
+    // Arène du thread appelant
+    static ScratchArena& local();
+
+    // Capacité minimale des entiers (2 * bits + 128 bits : un produit de
+    // deux réduits) ; ne fait que grandir, la valeur des entiers est gardée
+    void reserve(unsigned long bits);
+
+    // Portée : tout ce qui est pris après la construction est rendu par
+    // le destructeur. bits > 0 : reserve(bits) à l'entrée.
+    class Frame {
+    public:
+        explicit Frame(unsigned long bits = 0);
+        ~Frame();
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        // Entier libre suivant (valeur quelconque)
+        mpz_class& num() { return arena_.num(); }
+        // n mots contigus (contenu quelconque)
+        mp_limb_t* limbs(std::size_t n) { return arena_.limbs(n); }
+
+    private:
+        ScratchArena& arena_;
+        std::size_t top_, block_, offset_;
+    };
+
+    // Nombre d'entiers et de mots détenus (tailles atteintes, pour les
+    // bancs d'essai)
+    std::size_t nums() const { return nums_.size(); }
+    std::size_t words() const;
+
+private:
+    ScratchArena() = default;
+
+    mpz_class& num();
+    mp_limb_t* limbs(std::size_t n);
+
+    std::deque<mpz_class> nums_;     // deque : adresses stables
+    std::size_t top_ = 0;
+    unsigned long bits_ = 0;
+
+    std::vector<std::vector<mp_limb_t>> blocks_;
+    std::size_t block_ = 0, offset_ = 0;
+};
+
+#endif  // ARENA_H
@@ -0,0 +1,35 @@
+#ifndef BARRETT_H
+#define BARRETT_H
+
+#include <gmpxx.h>
+#include "base.h"
+
+// ============================================================
+// Contexte de Barrett — construit une seule fois par module
+//   b  = 2^64 (base des mots), k = nombre de mots de n
+//   mu = floor(b^(2k) / n)
+// reduce(x) pour 0 <= x < b^(2k) : deux multiplications et au plus
+// deux soustractions, au lieu de l'échelle de doublements de modulo().
+// ============================================================
+class BarrettContext {
+public:
+    explicit BarrettContext(const mpz_class& n);
+
+    const mpz_class& modulus() const { return n_; }
+
+    // x mod n ; hors de [0, b^(2k)) on retombe sur modulo()
+    mpz_class reduce(const mpz_class& x) const { mpz_class r; reduce(r, x); return r; }
+    // En place (r peut être x), temporaires dans l'arène du thread
+    void reduce(mpz_class& r, const mpz_class& x) const;
+    // r = a * b mod n, pour a et b dans [0, n)
+    void mul(mpz_class& r, const mpz_class& a, const mpz_class& b) const;
+
+private:
+    mpz_class n_;
+    mpz_class mu_;
+    mpz_class bound_;            // b^(2k)
+    unsigned long shift_lo_;     // 64*(k-1)
+    unsigned long shift_hi_;     // 64*(k+1)
+};
+
+#endif  // BARRETT_H
@@ -4,13 +4,34 @@
 #include <iostream>
 #include <gmpxx.h>
 #include <vector>
+#include <cstddef>
 
-mpz_class modulo(mpz_class a, mpz_class n);
-mpz_class quotient(mpz_class a, mpz_class n);
-mpz_class division_euclidienne(mpz_class a, mpz_class n, mpz_class &r);
+class BarrettContext;
+
+mpz_class modulo(const mpz_class& a, const mpz_class& n);
+// Réduction par un contexte de Barrett précalculé (module fixe)
+mpz_class modulo(const mpz_class& a, const BarrettContext& ctx);
+mpz_class quotient(const mpz_class& a, const mpz_class& n);
+mpz_class division_euclidienne(const mpz_class& a, const mpz_class& n, mpz_class &r);
 
 mpz_class ExpoMod(mpz_class base, mpz_class exp, mpz_class n);
 mpz_class mod_exp_window(mpz_class base, mpz_class exp, mpz_class n);
+// prod bases[i]^exps[i] mod n, une seule chaîne de carrés (Straus / Shamir)
+mpz_class mod_multi_exp(const std::vector<mpz_class>& bases,
+                        const std::vector<mpz_class>& exps, const mpz_class& n);
+// Fenêtre fixe à accès mémoire indépendant de l'exposant (module impair)
+mpz_class mod_exp_consttime(const mpz_class& base, const mpz_class& exp, const mpz_class& n);
+// Exposant public fixe e = 65537 : 16 carrés + 1 multiplication
+mpz_class mod_exp_65537(const mpz_class& base, const mpz_class& n);
 void stringToNum(mpz_class& num, const std::string& str);
 void numToString(std::string& str, const mpz_class& num);
+
+// Conversions octets <-> entier, big-endian, mot de 64 bits par mot de 64 bits
+// (aucune std::string intermédiaire)
+void bytesToNum(mpz_class& num, const std::byte* data, std::size_t len);
+// Écrit num (>= 0) sur le minimum d'octets ; retourne ce nombre d'octets.
+// Si cap est trop petit, rien n'est écrit (la valeur retournée dit la taille utile).
+std::size_t numToBytes(std::byte* out, std::size_t cap, const mpz_class& num);
+// Écrit num sur exactement len octets (zéros à gauche) ; false s'il ne tient pas
+bool numToBytesFixed(std::byte* out, std::size_t len, const mpz_class& num);
 #endif  // BASE_H
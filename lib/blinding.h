@@ -0,0 +1,57 @@
+#ifndef BLINDING_H
+#define BLINDING_H
+
+#include <gmpxx.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "barrett.h"
+#include "rsa_key.h"
+
+// ============================================================
+// Réserve de facteurs d'aveuglement (r^e mod n, r^(-1) mod n)
+//   x^d = (x * r^e)^d * r^(-1) mod n
+// Les paires sont préparées par un thread d'arrière-plan : tirage des r,
+// inverses par lot (invmod_batch) et r^e par la clé publique. Le chemin
+// critique ne paie que deux multiplications modulaires.
+// Si la réserve est vide, la dernière paire servie est rafraîchie par
+// élévation au carré : (r^2)^e = (r^e)^2 et (r^2)^(-1) = (r^(-1))^2.
+// ============================================================
+class BlindingPool {
+public:
+    // seed = 0 : graine tirée de random_device ; seed != 0 : suite
+    // reproductible, réservée aux tests
+    explicit BlindingPool(const RsaPublicKey& pub, size_t capacity = 64,
+                          const mpz_class& seed = 0);
+    ~BlindingPool();
+
+    BlindingPool(const BlindingPool&) = delete;
+    BlindingPool& operator=(const BlindingPool&) = delete;
+
+    // Une paire (r^e, r^(-1)) jamais servie deux fois telle quelle
+    void take(mpz_class& re, mpz_class& rinv);
+
+    // a * b mod n (contexte de Barrett de n)
+    mpz_class mul(const mpz_class& a, const mpz_class& b) const;
+
+    size_t available() const;
+    size_t capacity() const { return capacity_; }
+
+private:
+    void refill_loop(const mpz_class& seed);
+
+    RsaPublicKey pub_;
+    BarrettContext bn_;
+    size_t capacity_;
+
+    mutable std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<std::pair<mpz_class, mpz_class>> pairs_;
+    std::pair<mpz_class, mpz_class> last_;
+    bool has_last_ = false;
+    bool stop_ = false;
+    std::thread worker_;
+};
+
+#endif  // BLINDING_H
@@ -0,0 +1,63 @@
+#ifndef CHACHA20_H
+#define CHACHA20_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================
+// ChaCha20 et Poly1305 (RFC 8439) — primitives symétriques du mode
+// hybride (voir stream.h). Implémentation portable, sans dépendance :
+//   - ChaCha20 : flot chiffrant, clé 256 bits, nonce 96 bits,
+//                compteur de blocs de 32 bits
+//   - Poly1305 : MAC à usage unique, clé 256 bits, étiquette 128 bits,
+//                calcul incrémental (update / finish)
+//   - aead_seal / aead_open : ChaCha20-Poly1305 (RFC 8439, §2.8)
+// ============================================================
+
+class ChaCha20 {
+public:
+    ChaCha20(const std::byte key[32], const std::byte nonce[12], uint32_t counter = 0);
+
+    // out = in XOR flot ; in et out peuvent coïncider. Les appels
+    // successifs continuent le flot (le reste d'un bloc est conservé).
+    void apply(std::byte* out, const std::byte* in, std::size_t len);
+
+    // Un bloc de 64 octets de flot pour le compteur donné
+    static void block(uint8_t out[64], const uint32_t state[16]);
+
+private:
+    uint32_t state_[16];
+    uint8_t ks_[64];
+    unsigned used_ = 64;   // octets déjà consommés dans ks_
+};
+
+class Poly1305 {
+public:
+    explicit Poly1305(const std::byte key[32]);
+
+    void update(const std::byte* data, std::size_t len);
+    // Complète le bloc courant par des zéros (alignement de l'AEAD)
+    void pad16();
+    void finish(std::byte tag[16]);
+
+private:
+    void blocks(const uint8_t* m, std::size_t len, uint64_t hibit);
+
+    uint64_t r_[3], h_[3], pad_[2];
+    uint8_t buf_[16];
+    unsigned buffered_ = 0;
+};
+
+// Chiffrement authentifié : out reçoit len octets chiffrés, tag 16 octets
+void aead_seal(std::byte* out, std::byte tag[16],
+               const std::byte key[32], const std::byte nonce[12],
+               const std::byte* aad, std::size_t aad_len,
+               const std::byte* in, std::size_t len);
+
+// Déchiffrement : false (et out non écrit) si l'étiquette ne correspond pas
+bool aead_open(std::byte* out, const std::byte tag[16],
+               const std::byte key[32], const std::byte nonce[12],
+               const std::byte* aad, std::size_t aad_len,
+               const std::byte* in, std::size_t len);
+
+#endif  // CHACHA20_H
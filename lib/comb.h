@@ -0,0 +1,34 @@
+#ifndef COMB_H
+#define COMB_H
+
+#include <gmpxx.h>
+#include <vector>
+#include "montgomery.h"
+
+// ============================================================
+// Exponentiation à base fixe — peigne de Lim–Lee
+//   L bits d'exposant rangés en h lignes de a = ceil(L/h) bits,
+//   chaque ligne coupée en v blocs de b = ceil(a/v) bits
+//   G[t][s] = prod_{i : bit i de s} g^(2^(i*a + t*b))
+// Précalcul : v * 2^h valeurs, une seule fois par (module, base).
+// Chaque exponentiation coûte ensuite b carrés et au plus a
+// multiplications, contre L carrés pour une fenêtre glissante.
+// ============================================================
+class FixedBaseComb {
+public:
+    FixedBaseComb(const mpz_class& n, const mpz_class& base,
+                  unsigned long max_bits, int h = 6, int v = 2);
+
+    // base^e mod n ; un exposant plus long que max_bits passe par la
+    // fenêtre glissante classique
+    mpz_class exp(const mpz_class& e) const;
+
+private:
+    MontgomeryContext ctx_;
+    mpz_class base_;
+    unsigned long L_, a_, b_;
+    int h_, v_;
+    std::vector<mpz_class> table_;   // G[t][s] en t*2^h + s, domaine de Montgomery
+};
+
+#endif  // COMB_H
@@ -0,0 +1,76 @@
+#ifndef CRT_CONTEXT_H
+#define CRT_CONTEXT_H
+
+#include <gmpxx.h>
+#include <memory>
+#include "montgomery.h"
+#include "barrett.h"
+#include "mont_lanes.h"
+
+// ============================================================
+// Précalculs CRT réutilisables pour une clé (p, q, qinv)
+//   contextes de Montgomery de p et q, Barrett de p (pour m2 mod p)
+//   et qinv déjà dans le domaine de p : h = REDC(qinv*R * (m1 - m2))
+//   si p et q ont le même nombre de mots en base 2^52, les deux moitiés
+//   peuvent aussi tourner de front sur deux voies de MontLanes
+//   si p et q font 512, 1024, 1536 ou 2048 bits (clés de 1024 à 4096
+//   bits), les exponentiations à fenêtre glissante passent par
+//   UIntMontgomery (uint.h) : entiers sur la pile, aucune allocation
+// ============================================================
+class CrtContext {
+public:
+    CrtContext(const mpz_class& p, const mpz_class& q, const mpz_class& qinv);
+
+    // x^d mod n à partir de dp = d mod (p-1) et dq = d mod (q-1) ;
+    // sur les voies vectorielles quand lanes() est vrai
+    mpz_class pow(const mpz_class& x, const mpz_class& dp, const mpz_class& dq) const {
+        mpz_class r;
+        pow(r, x, dp, dq);
+        return r;
+    }
+    // Exposants déjà découpés ; parallel = true : moitié p sur un second thread
+    mpz_class pow(const mpz_class& x, const ExpPlan& dp, const ExpPlan& dq,
+                  bool parallel = false) const {
+        mpz_class r;
+        pow(r, x, dp, dq, parallel);
+        return r;
+    }
+
+    // Même calcul avec l'exponentiation à temps constant sur p et q
+    mpz_class pow_consttime(const mpz_class& x, const mpz_class& dp, const mpz_class& dq,
+                            bool parallel = false) const {
+        mpz_class r;
+        pow_consttime(r, x, dp, dq, parallel);
+        return r;
+    }
+
+    // Variantes en place (r peut être x) : moitiés et Garner sur les
+    // entiers de l'arène du thread, aucune allocation sur un seul coeur
+    void pow(mpz_class& r, const mpz_class& x, const mpz_class& dp, const mpz_class& dq) const;
+    void pow(mpz_class& r, const mpz_class& x, const ExpPlan& dp, const ExpPlan& dq,
+             bool parallel = false) const;
+    void pow_consttime(mpz_class& r, const mpz_class& x, const mpz_class& dp,
+                       const mpz_class& dq, bool parallel = false) const;
+
+    // true si les deux moitiés vont plus vite sur MontLanes qu'une à une
+    // (noyau courant et taille de p, voir MontLanes::profitable) ;
+    // toujours faux quand fixed() est vrai
+    bool lanes() const;
+
+    // true si les moitiés à fenêtre glissante tournent sur UInt
+    bool fixed() const { return fixed_ != nullptr; }
+
+    struct FixedHalves;   // défini dans crt_context.cpp
+
+private:
+    void half(mpz_class& m, const mpz_class& x, const ExpPlan& plan, int side) const;
+    void combine(mpz_class& r, const mpz_class& m1, const mpz_class& m2) const;
+
+    MontgomeryContext mp_, mq_;
+    BarrettContext bp_;
+    mpz_class p_, q_, qinv_m_;
+    std::shared_ptr<const MontLanes> lanes_;   // nul si p et q de tailles différentes
+    std::shared_ptr<const FixedHalves> fixed_; // nul hors des tailles de UInt
+};
+
+#endif  // CRT_CONTEXT_H
@@ -0,0 +1,122 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// ============================================================
+// Compteurs d'instrumentation du chemin critique
+//   Activés à la compilation par -DRSA_INSTRUMENT (option CMake du même
+//   nom) ; sinon les macros RSA_COUNT / RSA_ADD / RSA_TIMED ne génèrent
+//   aucun code et les instantanés sont nuls.
+//   Chaque thread écrit dans ses propres compteurs (pas de partage de
+//   ligne de cache, pas d'instruction atomique verrouillée) ; un
+//   instantané peut être pris pour le thread courant ou pour le
+//   processus entier (somme de tous les threads, y compris terminés).
+//   Les cycles viennent de rdtsc (x86), sinon de l'horloge en ns.
+// ============================================================
+
+// Un champ par compteur ; X(nom, description)
+#define RSA_INSTRUMENT_COUNTERS(X)                                            \
+    X(modulo_calls,      "appels à modulo()")                               \
+    X(modulo_cycles,     "cycles dans modulo()")                            \
+    X(modulo_steps,      "pas de descente de l'échelle de modulo()")        \
+    X(mulmod_calls,      "appels à mulmod()")                               \
+    X(mulmod_cycles,     "cycles dans mulmod()")                            \
+    X(exp_calls,         "exponentiations (mod_exp_window, ExpoMod)")       \
+    X(exp_cycles,        "cycles dans les exponentiations")                 \
+    X(exp_squarings,     "élévations au carré des fenêtres")                \
+    X(exp_multiplies,    "multiplications des fenêtres (précalcul inclus)") \
+    X(prime_candidates,  "candidats soumis à primTest()")                   \
+    X(sieve_rejects,     "candidats éliminés par le crible de genAlea()")   \
+    X(trialdiv_rejects,  "candidats rejetés par trialDiv()")                \
+    X(mr_rejects,        "candidats rejetés par Miller-Rabin")              \
+    X(mr_rounds,         "tours de Miller-Rabin")                           \
+    X(lucas_tests,       "tests de Lucas forts (BailliePSW)")               \
+    X(lucas_rejects,     "candidats rejetés par le test de Lucas")          \
+    X(gcd_calls,         "appels à extended_gcd() / lehmer_gcd()")          \
+    X(gcd_iterations,    "itérations d'Euclide (Lehmer)")
+
+struct InstrumentSnapshot {
+#define RSA_INSTRUMENT_FIELD(name, desc) uint64_t name = 0;
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+
+    InstrumentSnapshot& operator+=(const InstrumentSnapshot& o);
+    InstrumentSnapshot operator-(const InstrumentSnapshot& o) const;
+};
+
+// true si la bibliothèque a été compilée avec RSA_INSTRUMENT
+bool instrument_enabled();
+// Compteurs du thread appelant
+InstrumentSnapshot instrument_snapshot();
+// Somme sur tous les threads du processus
+InstrumentSnapshot instrument_snapshot_all();
+// Remise à zéro des compteurs du thread appelant
+void instrument_reset();
+// Une ligne "nom valeur  # description" par compteur
+std::string instrument_dump(const InstrumentSnapshot& s);
+
+#ifdef RSA_INSTRUMENT
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+inline uint64_t instrument_cycles() { return __rdtsc(); }
+#else
+#include <chrono>
+inline uint64_t instrument_cycles() {
+    return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+}
+#endif
+
+// Compteurs vivants d'un thread : seul ce thread les écrit, les lectures
+// croisées (instrument_snapshot_all) sont relâchées
+struct InstrumentCounters {
+#define RSA_INSTRUMENT_FIELD(name, desc) std::atomic<uint64_t> name{0};
+    RSA_INSTRUMENT_COUNTERS(RSA_INSTRUMENT_FIELD)
+#undef RSA_INSTRUMENT_FIELD
+
+    InstrumentCounters();
+    ~InstrumentCounters();
+};
+
+inline InstrumentCounters& instrument_local() {
+    thread_local InstrumentCounters c;
+    return c;
+}
+
+inline void instrument_add(std::atomic<uint64_t>& c, uint64_t v) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+// Cycles écoulés entre construction et destruction
+class InstrumentTimer {
+public:
+    explicit InstrumentTimer(std::atomic<uint64_t>& c) : c_(c), t0_(instrument_cycles()) {}
+    ~InstrumentTimer() { instrument_add(c_, instrument_cycles() - t0_); }
+
+private:
+    std::atomic<uint64_t>& c_;
+    uint64_t t0_;
+};
+
+#define RSA_INSTRUMENT_CAT2(a, b) a##b
+#define RSA_INSTRUMENT_CAT(a, b) RSA_INSTRUMENT_CAT2(a, b)
+
+#define RSA_ADD(counter, v) instrument_add(instrument_local().counter, (v))
+#define RSA_COUNT(counter) RSA_ADD(counter, 1)
+// Compte l'appel et mesure les cycles jusqu'à la fin du bloc
+#define RSA_TIMED(prefix)                                                     \
+    RSA_COUNT(prefix##_calls);                                                \
+    InstrumentTimer RSA_INSTRUMENT_CAT(rsa_timer_, __LINE__)(instrument_local().prefix##_cycles)
+
+#else
+
+#define RSA_ADD(counter, v) ((void)0)
+#define RSA_COUNT(counter) ((void)0)
+#define RSA_TIMED(prefix) ((void)0)
+
+#endif  // RSA_INSTRUMENT
+
+#endif  // INSTRUMENT_H
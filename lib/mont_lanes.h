@@ -0,0 +1,78 @@
+#ifndef MONT_LANES_H
+#define MONT_LANES_H
+
+#include <gmpxx.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// Montgomery sur plusieurs voies : jusqu'à LANES = 8 multiplications
+// modulaires indépendantes (un module par voie, même nombre de mots)
+// calculées de front, sur les unités vectorielles.
+//   - base 2^52 : m = ceil((bits + 2) / 52) mots, R = 2^(52m) > 4n
+//   - structure de tableaux : le mot j des 8 voies est contigu
+//     (x[8j .. 8j+8)), soit un registre AVX-512 ou deux AVX2
+//   - multiplication « presque Montgomery » : entrées et sorties < 2n,
+//     pas de soustraction finale avant la sortie du domaine
+// Noyaux, choisis à l'exécution selon le processeur :
+//   avx512ifma  vpmadd52luq / vpmadd52huq, 8 voies par instruction
+//   avx2        produits 52x52 bits en quatre vpmuludq 26x26, 4 voies
+//   portable    produits 64x64 -> 128 bits, voie par voie
+// ============================================================
+
+// Constantes d'un module pour le noyau à voies ; construites une fois
+// par clé (deux réductions par l'échelle de modulo())
+class LaneModulus {
+public:
+    explicit LaneModulus(const mpz_class& n);
+
+    const mpz_class& modulus() const { return n_; }
+    std::size_t limbs() const { return m_; }
+
+private:
+    friend class MontLanes;
+    mpz_class n_;
+    std::size_t m_;
+    uint64_t n0_;                  // -n^(-1) mod 2^52
+    std::vector<uint64_t> n52_;    // n en base 2^52
+    std::vector<uint64_t> one_;    // R mod n
+    std::vector<uint64_t> r2_;     // R^2 mod n
+};
+
+class MontLanes {
+public:
+    static constexpr std::size_t LANES = 8;
+
+    // 1 à LANES modules de même nombre de mots (les voies restantes
+    // répètent le premier et leurs résultats sont ignorés)
+    explicit MontLanes(const std::vector<const LaneModulus*>& moduli);
+
+    std::size_t size() const { return used_; }
+    std::size_t limbs() const { return m_; }
+
+    // r[i] = bases[i]^exps[i] mod n_i, 0 <= bases[i] < n_i, exps[i] >= 0
+    //   exposants tous égaux : fenêtre glissante commune (window_plan)
+    //   sinon : fenêtre fixe sur la longueur du plus grand exposant
+    void exp(std::vector<mpz_class>& r, const std::vector<mpz_class>& bases,
+             const std::vector<mpz_class>& exps) const;
+    // Même calcul sur size() pointeurs (aucun vecteur construit) : les
+    // tampons viennent de l'arène du thread ; r[i] ne doit pas être un exposant
+    void exp(mpz_class* const* r, const mpz_class* const* bases,
+             const mpz_class* const* exps) const;
+
+    // Noyau utilisé : "avx512ifma", "avx2" ou "portable"
+    static const char* kernel();
+    // Force un noyau (bancs d'essai) ; false s'il n'est pas disponible
+    static bool select_kernel(const char* name);
+    // true si count exponentiations de modules de bits bits vont plus
+    // vite sur les voies que une à une (MontgomeryContext)
+    static bool profitable(std::size_t bits, std::size_t count);
+
+private:
+    std::size_t used_, m_;
+    std::vector<uint64_t> n_, n0_, one_, r2_;
+    std::vector<mpz_class> mod_;
+};
+
+#endif  // MONT_LANES_H
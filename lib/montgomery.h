@@ -0,0 +1,101 @@
+#ifndef MONTGOMERY_H
+#define MONTGOMERY_H
+
+#include <gmpxx.h>
+#include <vector>
+#include "base.h"
+#include "window.h"
+
+// ============================================================
+// Contexte de Montgomery — construit une seule fois par module
+//   n  : module impair (n > 1)
+//   R  = 2^k, k multiple de 64 et R > n
+//   n' = -n^(-1) mod R
+//   R2 = R^2 mod n   (sert à entrer dans le domaine)
+// La réduction REDC n'utilise que +, -, * et des décalages de mots.
+// ============================================================
+class MontgomeryContext {
+public:
+    explicit MontgomeryContext(const mpz_class& n);
+
+    const mpz_class& modulus() const { return n_; }
+    unsigned long bits() const { return k_; }
+
+    // R mod n : représentation de 1 dans le domaine de Montgomery
+    const mpz_class& one() const { return one_; }
+
+    // REDC(T) = T * R^(-1) mod n, pour 0 <= T < n*R
+    mpz_class redc(const mpz_class& T) const { mpz_class r; redc(r, T); return r; }
+
+    // a -> a*R mod n (a dans [0, n)) et retour
+    mpz_class to_mont(const mpz_class& a) const { return mul(a, R2_); }
+    mpz_class from_mont(const mpz_class& a) const { return redc(a); }
+
+    // x mod n directement dans le domaine, pour 0 <= x < n*R (par ex. un
+    // chiffré modulo p*q vu par le facteur p) : deux REDC, sans modulo()
+    mpz_class to_mont_reduce(const mpz_class& x) const {
+        mpz_class r;
+        redc(r, x);
+        mul(r, r, R3_);
+        return r;
+    }
+
+    // Produit dans le domaine : REDC(a*b)
+    mpz_class mul(const mpz_class& a, const mpz_class& b) const { mpz_class r; mul(r, a, b); return r; }
+
+    // base^exp mod n, entièrement calculé dans le domaine de Montgomery
+    mpz_class exp(const mpz_class& base, const mpz_class& exp) const;
+    // Même calcul avec une découpe de l'exposant déjà faite (window_plan)
+    mpz_class exp(const mpz_class& base, const ExpPlan& plan) const {
+        mpz_class r;
+        this->exp(r, base, plan);
+        return r;
+    }
+
+    // prod bases[i]^exps[i] mod n en une seule chaîne de carrés
+    // (fenêtres entrelacées, voir apply_multi) ; exps[i] >= 0
+    mpz_class multi_exp(const std::vector<mpz_class>& bases,
+                        const std::vector<mpz_class>& exps) const;
+
+    // Mode à temps constant : fenêtre fixe, toujours w carrés puis une
+    // multiplication par fenêtre, et lecture de la table qui parcourt
+    // toutes les entrées (disposition dispersée, voir montgomery.cpp).
+    // Le nombre de fenêtres dépend de la taille du module, pas de exp.
+    mpz_class exp_consttime(const mpz_class& base, const mpz_class& exp) const {
+        mpz_class r;
+        exp_consttime(r, base, exp);
+        return r;
+    }
+
+    // base^65537 : chaîne d'addition fixe, 16 carrés puis 1 multiplication
+    mpz_class exp_65537(const mpz_class& base) const;
+
+    // Entrée dans le domaine pour une base quelconque (repliements par
+    // REDC au-delà de n*R, modulo() seulement pour une base négative)
+    mpz_class enter(const mpz_class& base) const { mpz_class r; enter(r, base); return r; }
+
+    // Variantes en place des mêmes calculs : le résultat va dans r (qui
+    // peut être une des entrées), les temporaires et la table de fenêtres
+    // viennent de l'arène du thread (arena.h). Sans allocation une fois
+    // l'arène et r à la taille du module.
+    void redc(mpz_class& r, const mpz_class& T) const;
+    void mul(mpz_class& r, const mpz_class& a, const mpz_class& b) const;
+    void enter(mpz_class& r, const mpz_class& base) const;
+    void exp(mpz_class& r, const mpz_class& base, const ExpPlan& plan) const;
+    // Même exponentiation, résultat laissé dans le domaine (base^e * R mod n),
+    // pour enchaîner d'autres produits sans ressortir
+    void exp_mont(mpz_class& r, const mpz_class& base, const ExpPlan& plan) const;
+    void exp_consttime(mpz_class& r, const mpz_class& base, const mpz_class& exp) const;
+
+private:
+    mpz_class n_;
+    mpz_class n_prime_;   // -n^(-1) mod R
+    mpz_class mask_;      // R - 1 : "mod R" = troncature aux k bits de poids faible
+    mpz_class R2_;
+    mpz_class R3_;        // R^3 mod n
+    mpz_class bound_;     // n*R : domaine de validité de REDC
+    mpz_class one_;
+    unsigned long k_;
+};
+
+#endif  // MONTGOMERY_H
@@ -3,21 +3,32 @@
 
 #include <gmpxx.h>
 #include <tuple>
+#include <vector>
 #include "base.h"
 
 // Multiplication modulaire
 mpz_class mulmod(const mpz_class& A, const mpz_class& B, const mpz_class& n);
+// Multiplication modulaire avec un contexte de Barrett précalculé
+mpz_class mulmod(const mpz_class& A, const mpz_class& B, const BarrettContext& ctx);
 
-// Euclide étendu : retourne (pgcd, x, y) tels que A*x + B*y = pgcd(A, B)
-std::tuple<mpz_class, mpz_class, mpz_class> extended_gcd(mpz_class A, mpz_class B);
+// Euclide étendu (Lehmer) : retourne (pgcd, x, y) tels que A*x + B*y = pgcd(A, B)
+std::tuple<mpz_class, mpz_class, mpz_class> extended_gcd(const mpz_class& A, const mpz_class& B);
+
+// PGCD seul (Lehmer, sans coefficients de Bezout)
+mpz_class lehmer_gcd(const mpz_class& A, const mpz_class& B);
 
 // Inverse modulaire via Euclide étendu
 mpz_class invmod(const mpz_class& A, const mpz_class& n);
 
-// PGCD via Euclide étendu
+// Inverses de tous les A[i] modulo n (astuce de Montgomery) : une seule
+// inversion et 3(k-1) multiplications modulaires. Retourne -1 si tout est
+// inversible, sinon l'indice du premier élément non inversible (inv vide).
+long invmod_batch(std::vector<mpz_class>& inv, const std::vector<mpz_class>& A,
+                  const mpz_class& n);
+
+// PGCD via Euclide de Lehmer
 inline mpz_class op_pgcd(const mpz_class& A, const mpz_class& B) {
-    auto [g, x, y] = extended_gcd(A, B);
-    return g;
+    return lehmer_gcd(A, B);
 }
 
 #endif  // OP_MOD_H
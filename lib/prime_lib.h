@@ -3,18 +3,74 @@
 
 #include <gmpxx.h>
 #include <array>
+#include <atomic>
 #include "base.h"
+#include "barrett.h"
+#include "montgomery.h"
+#include "window.h"
 
 constexpr std::array<unsigned int, 22> SmallPrimes = {
     7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u, 41u, 43u,
     47u, 53u, 59u, 61u, 67u, 71u, 73u, 79u, 83u, 89u, 97u
 };
 
+// ============================================================
+// Tests de primalité
+//   n < 2^64        Miller-Rabin déterministe (bases 2, 3, ..., 37)
+//   MillerRabin     base 2, puis t bases aléatoires ; t donné par les
+//                   bornes de Damgård-Landrock-Pomerance pour la taille
+//                   de n et l'erreur visée (celles des tables de
+//                   FIPS 186-5, annexe B.3)
+//   BailliePSW      base 2 puis Lucas fort (paramètres de Selfridge) ;
+//                   aucun contre-exemple connu, à préférer pour un n
+//                   choisi par un tiers
+// Dans tous les modes la base 2 passe en premier : la plupart des
+// composés s'arrêtent là, après une seule exponentiation. Un seul
+// contexte de Montgomery est construit par candidat, partagé par toutes
+// les bases et par le test de Lucas.
+// ============================================================
+enum class PrimalityMode { MillerRabin, BailliePSW };
+
+struct PrimalityConfig {
+    PrimalityMode mode = PrimalityMode::MillerRabin;
+    // Erreur visée 2^-error_bits pour un candidat aléatoire ; 0 : selon la
+    // taille du module RSA 2*bits (2^-100, 2^-112 puis 2^-128)
+    unsigned error_bits = 0;
+    // Bases aléatoires après la base 2 ; 0 : mr_rounds() en mode
+    // MillerRabin, aucune en mode BailliePSW
+    unsigned rounds = 0;
+};
+
+// Erreur visée par défaut pour un premier de bits bits
+unsigned fips_error_bits(unsigned long bits);
+// Plus petit t tel que p(bits, t) <= 2^-error_bits : probabilité qu'un
+// entier impair aléatoire de bits bits passe t tours de Miller-Rabin à
+// bases aléatoires sans être premier (bits >= 21)
+unsigned mr_rounds(unsigned long bits, unsigned error_bits);
+
 bool trialDiv(const mpz_class& n);
+// Un tour de base a sur n = mc.modulus(), n - 1 = d * 2^s (plan : window_plan(d)),
+// 1 < a < n - 1 ; exponentiation et carrés dans le domaine de mc
+bool miller_rabin(const MontgomeryContext& mc, const ExpPlan& d, unsigned long s,
+                  const mpz_class& a);
 bool miller_rabin(const mpz_class& n, const mpz_class& n_1,
                   const mpz_class& d, unsigned long s,
                   const mpz_class& a);
-bool primTest(const mpz_class& n);
+bool miller_rabin(const mpz_class& n, const mpz_class& n_1,
+                  const mpz_class& d, unsigned long s,
+                  const mpz_class& a, const BarrettContext& ctx);
+// Lucas fort sur n = mc.modulus() impair, sans petit facteur (trialDiv)
+bool strong_lucas(const MontgomeryContext& mc);
+
+// Bases aléatoires tirées de rng ; sans rng, d'un générateur par thread
+bool primTest(const mpz_class& n, const PrimalityConfig& cfg, gmp_randclass& rng);
+bool primTest(const mpz_class& n, const PrimalityConfig& cfg = PrimalityConfig());
 mpz_class genAlea(gmp_randclass& rng, unsigned long bits);
+// Variante annulable : retourne 0 dès que *stop passe à true
+mpz_class genAlea(gmp_randclass& rng, unsigned long bits, const std::atomic<bool>* stop,
+                  const PrimalityConfig& cfg = PrimalityConfig());
+// p et q distincts, cherchés sur plusieurs threads
+void genAleaPair(gmp_randclass& rng, unsigned long bits, mpz_class& p, mpz_class& q,
+                 const PrimalityConfig& cfg = PrimalityConfig());
 
 #endif  // PRIME_LIB_H
@@ -0,0 +1,64 @@
+#ifndef PRIME_POOL_H
+#define PRIME_POOL_H
+
+#include <gmpxx.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "prime_lib.h"
+
+// ============================================================
+// Réserve de nombres premiers pré-générés
+//   - une file bornée sans verrou par taille servie (MPMC de Vyukov :
+//     un numéro de séquence par case, deux compteurs atomiques) ;
+//     prendre un premier coûte deux opérations atomiques et un mpz_swap
+//   - des threads d'arrière-plan complètent en priorité la file la moins
+//     remplie (premiers en cours de génération compris) et dorment quand
+//     toutes sont pleines
+//   - file vide : l'appelant génère lui-même (genAlea), rien n'attend
+// Les premiers servis ne le sont qu'une fois : une paire (p, q) tirée de
+// la réserve est aussi secrète que deux appels à genAlea.
+// ============================================================
+
+// État d'une taille servie, pour régler capacité et nombre de threads
+struct PrimePoolStats {
+    unsigned long bits;
+    std::size_t depth;       // premiers prêts
+    std::size_t capacity;
+    uint64_t generated;      // produits par les threads d'arrière-plan
+    uint64_t served;         // pris dans la file
+    uint64_t misses;         // file vide : génération par l'appelant
+    double refill_rate;      // premiers produits par seconde depuis la création
+    double mean_gen_ms;      // durée moyenne de génération d'un premier
+};
+
+class PrimePool {
+public:
+    // capacity : premiers gardés par taille (arrondi à une puissance de 2) ;
+    // threads = 0 : un thread par coeur ; seed = 0 : 256 bits de
+    // random_device par thread (seed != 0 : seed + i pour le thread i, suite
+    // reproductible, pour les tests)
+    explicit PrimePool(const std::vector<unsigned long>& sizes = {512, 1024, 1536, 2048},
+                       std::size_t capacity = 16, unsigned threads = 1,
+                       unsigned long seed = 0,
+                       const PrimalityConfig& cfg = PrimalityConfig());
+    ~PrimePool();
+
+    PrimePool(const PrimePool&) = delete;
+    PrimePool& operator=(const PrimePool&) = delete;
+
+    // Un premier de bits bits pris dans la file ; false si elle est vide
+    // (compté comme un défaut) ou si la taille n'est pas servie
+    bool try_take(unsigned long bits, mpz_class& p);
+    // try_take, sinon genAlea(rng, bits) sur le thread appelant
+    mpz_class take(unsigned long bits, gmp_randclass& rng);
+
+    std::vector<PrimePoolStats> stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif  // PRIME_POOL_H
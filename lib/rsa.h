@@ -3,16 +3,22 @@
 
 #include <gmpxx.h>
 #include <string>
+#include "rsa_key.h"
 using namespace std;
 
 void keyGen(unsigned long bits, gmp_randclass& rng,
             mpz_class& n, mpz_class& e, mpz_class& d,
             mpz_class& p, mpz_class& q, mpz_class& phi);
 
+// Un seul bloc : m doit être < n (au-delà, voir le mode hybride de stream.h)
 void enc(mpz_class& c, std::string m, const mpz_class& e, const mpz_class& n);
 void dec(string& m, const mpz_class& c, const mpz_class& d, const mpz_class& n);
 
 void sing(mpz_class& signature, const string& message, const mpz_class& d, const mpz_class& n);
 bool verify(const mpz_class& signature, const string& message, const mpz_class& e, const mpz_class& n);
 
+// Variantes sur clé publique précalculée (voir rsa_key.h)
+void enc(mpz_class& c, const std::string& m, const RsaPublicKey& key);
+bool verify(const mpz_class& signature, const string& message, const RsaPublicKey& key);
+
 #endif  // RSA_H
@@ -0,0 +1,52 @@
+#ifndef RSA_BATCH_H
+#define RSA_BATCH_H
+
+#include <gmpxx.h>
+#include <string>
+#include <vector>
+#include "rsa_key.h"
+
+// ============================================================
+// Opérations privées par lot, pour une même clé (p, q, dp, dq, qinv)
+// Les contextes de réduction de p et q sont construits une seule fois
+// pour tout le lot au lieu d'une fois par opération.
+// ============================================================
+
+void dec_crt_batch(std::vector<std::string>& m, const std::vector<mpz_class>& c,
+                   const mpz_class& p, const mpz_class& q,
+                   const mpz_class& dp, const mpz_class& dq,
+                   const mpz_class& qinv);
+
+void sing_crt_batch(std::vector<mpz_class>& signatures,
+                    const std::vector<std::string>& messages,
+                    const mpz_class& p, const mpz_class& q,
+                    const mpz_class& dp, const mpz_class& dq,
+                    const mpz_class& qinv);
+
+// Mêmes lots sur une clé précalculée
+void dec_crt_batch(std::vector<std::string>& m, const std::vector<mpz_class>& c,
+                   const RsaPrivateKey& key);
+
+void sing_crt_batch(std::vector<mpz_class>& signatures,
+                    const std::vector<std::string>& messages,
+                    const RsaPrivateKey& key);
+
+// Batch RSA de Fiat : c[i] a été chiffré avec l'exposant public e[i]
+// (même module n = p*q). Si les e[i] sont premiers entre eux deux à deux
+// et premiers avec phi, les k racines coûtent une seule exponentiation
+// complète plus des opérations à petits exposants dans un arbre binaire.
+// Sinon, repli sur le CRT à précalculs partagés.
+void dec_batch_fiat(std::vector<std::string>& m, const std::vector<mpz_class>& c,
+                    const std::vector<mpz_class>& e,
+                    const mpz_class& p, const mpz_class& q);
+
+// Vérifications par lot, clés quelconques : ok[i] = (sigs[i]^e_i mod n_i
+// == msgs[i]) pour la clé keys[i]. Les signatures de modules de même
+// taille sont élevées à leur exposant par groupes de 8 sur les voies de
+// MontLanes, une à une si le noyau vectoriel n'y gagne pas. Une
+// signature hors de [0, n_i) est refusée.
+void verify_batch(std::vector<bool>& ok, const std::vector<mpz_class>& sigs,
+                  const std::vector<std::string>& msgs,
+                  const std::vector<const RsaPublicKey*>& keys);
+
+#endif  // RSA_BATCH_H
@@ -3,23 +3,40 @@
 
 #include <gmpxx.h>
 #include <string>
+#include "rsa_key.h"
 
+class PrimePool;
+
+// pool : p et q pris dans la réserve (prime_pool.h) s'il y en a, sinon
+// générés sur place ; nullptr : recherche parallèle (genAleaPair)
 void keyGen_crt(unsigned long bits, gmp_randclass& rng,
                 mpz_class& n, mpz_class& e, mpz_class& d,
                 mpz_class& p, mpz_class& q, mpz_class& phi,
-                mpz_class& dp, mpz_class& dq, mpz_class& qinv);
+                mpz_class& dp, mpz_class& dq, mpz_class& qinv,
+                PrimePool* pool = nullptr);
 
 
 
+// parallel = true : les exponentiations modulo p et modulo q tournent
+// sur deux coeurs, puis se rejoignent pour la recombinaison de Garner
 void dec_crt(std::string& m, const mpz_class& c,
              const mpz_class& p, const mpz_class& q,
              const mpz_class& dp, const mpz_class& dq,
-             const mpz_class& qinv);
+             const mpz_class& qinv, bool parallel = false);
 
 void sing_crt(mpz_class& signature, const std::string& message,
               const mpz_class& p, const mpz_class& q,
               const mpz_class& dp, const mpz_class& dq,
-              const mpz_class& qinv);
+              const mpz_class& qinv, bool parallel = false);
+
+// Mêmes opérations sur une clé précalculée (voir rsa_key.h)
+RsaPrivateKey keyGen_crt(unsigned long bits, gmp_randclass& rng, PrimePool* pool = nullptr);
+
+void dec_crt(std::string& m, const mpz_class& c, const RsaPrivateKey& key,
+             bool parallel = false);
+
+void sing_crt(mpz_class& signature, const std::string& message,
+              const RsaPrivateKey& key, bool parallel = false);
 
 
 #endif  // RSA_CRT_H
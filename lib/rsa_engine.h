@@ -0,0 +1,45 @@
+#ifndef RSA_ENGINE_H
+#define RSA_ENGINE_H
+
+#include <gmpxx.h>
+#include <future>
+#include <memory>
+#include <string>
+#include "rsa_key.h"
+
+// ============================================================
+// RsaEngine — moteur RSA multi-thread pour une clé
+//   - un pool de workers à vol de tâches (une file par worker ;
+//     un worker inoccupé vole dans les files des autres)
+//   - chaque worker garde sa propre copie de la clé précalculée
+//     (RsaPrivateKey : contextes de p, q et n, découpes des exposants)
+//     et son propre flux aléatoire (qui amorce sa réserve d'aveuglement
+//     si la clé est aveuglée)
+//   - les résultats reviennent par std::future
+// Toutes les méthodes de soumission sont utilisables depuis n'importe
+// quel thread, y compris depuis une tâche du moteur.
+// ============================================================
+class RsaEngine {
+public:
+    // threads = 0 : un worker par coeur ; seed = 0 : graines tirées de
+    // random_device (seed != 0 : seed + i pour le worker i, pour les tests)
+    explicit RsaEngine(const RsaPrivateKey& key,
+                       unsigned threads = 0, unsigned long seed = 0);
+    ~RsaEngine();
+
+    RsaEngine(const RsaEngine&) = delete;
+    RsaEngine& operator=(const RsaEngine&) = delete;
+
+    std::future<mpz_class>   sign(std::string message);
+    std::future<std::string> decrypt(mpz_class c);
+    std::future<mpz_class>   encrypt(std::string message);
+    std::future<bool>        verify(mpz_class signature, std::string message);
+
+    unsigned threads() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif  // RSA_ENGINE_H
@@ -0,0 +1,96 @@
+#ifndef RSA_KEY_H
+#define RSA_KEY_H
+
+#include <gmpxx.h>
+#include <memory>
+#include "montgomery.h"
+#include "crt_context.h"
+#include "mont_lanes.h"
+#include "window.h"
+
+// ============================================================
+// Clés RSA précalculées — construites une fois, utilisées souvent
+//   RsaPublicKey  : n, e, contexte de Montgomery de n, découpe de e,
+//                   constantes de n pour MontLanes (verify_batch)
+//   RsaPrivateKey : n, e, d, p, q, dp, dq, qinv, contextes de p et q
+//                   (CrtContext), découpes de dp et dq, clé publique
+// Les fonctions du chemin critique (enc, verify, dec_crt, sing_crt)
+// ont des surcharges qui prennent ces objets : plus aucun précalcul
+// n'est refait à chaque appel.
+// ============================================================
+class BlindingPool;
+
+class RsaPublicKey {
+public:
+    RsaPublicKey(const mpz_class& n, const mpz_class& e);
+
+    const mpz_class& n() const { return n_; }
+    const mpz_class& e() const { return e_; }
+
+    // x^e mod n (chaîne fixe si e = 65537)
+    mpz_class pow(const mpz_class& x) const {
+        return f4_ ? mn_.exp_65537(x) : mn_.exp(x, e_plan_);
+    }
+
+    // Partagées entre les copies de la clé
+    const LaneModulus& lane_modulus() const { return *lanes_; }
+
+private:
+    mpz_class n_, e_;
+    bool f4_;
+    MontgomeryContext mn_;
+    ExpPlan e_plan_;
+    std::shared_ptr<const LaneModulus> lanes_;
+};
+
+class RsaPrivateKey {
+public:
+    RsaPrivateKey(const mpz_class& n, const mpz_class& e, const mpz_class& d,
+                  const mpz_class& p, const mpz_class& q,
+                  const mpz_class& dp, const mpz_class& dq,
+                  const mpz_class& qinv);
+
+    const mpz_class& n() const { return pub_.n(); }
+    const mpz_class& e() const { return pub_.e(); }
+    const mpz_class& d() const { return d_; }
+    const mpz_class& p() const { return p_; }
+    const mpz_class& q() const { return q_; }
+    const mpz_class& dp() const { return dp_; }
+    const mpz_class& dq() const { return dq_; }
+    const mpz_class& qinv() const { return qinv_; }
+
+    const RsaPublicKey& public_key() const { return pub_; }
+
+    // Exponentiations privées à temps constant (fenêtre fixe, table dispersée)
+    void set_constant_time(bool on) { consttime_ = on; }
+    bool constant_time() const { return consttime_; }
+
+    // Aveuglement des opérations privées par une réserve de paires
+    // (r^e, r^(-1)) remplie en arrière-plan (voir blinding.h). Les copies
+    // de la clé partagent la même réserve. seed = 0 : random_device.
+    void enable_blinding(size_t capacity = 64, const mpz_class& seed = 0);
+    bool blinding() const { return blinding_ != nullptr; }
+    size_t blinding_capacity() const;
+
+    // x^d mod n par CRT ; parallel = true : les deux moitiés sur deux coeurs
+    mpz_class pow(const mpz_class& x, bool parallel = false) const {
+        mpz_class r;
+        pow(r, x, parallel);
+        return r;
+    }
+    // En place (r peut être x) : sur un seul coeur et sans aveuglement,
+    // aucune allocation une fois r et l'arène du thread à la bonne taille
+    void pow(mpz_class& r, const mpz_class& x, bool parallel = false) const;
+
+private:
+    void pow_crt(mpz_class& r, const mpz_class& x, bool parallel) const;
+
+    RsaPublicKey pub_;
+    mpz_class d_, p_, q_, dp_, dq_, qinv_;
+    CrtContext crt_;
+    ExpPlan dp_plan_, dq_plan_;
+    bool consttime_ = false;
+    std::shared_ptr<BlindingPool> blinding_;
+};
+
+#endif  // RSA_KEY_H
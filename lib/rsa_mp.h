@@ -0,0 +1,99 @@
+#ifndef RSA_MP_H
+#define RSA_MP_H
+
+#include <gmpxx.h>
+#include <string>
+#include <vector>
+#include "montgomery.h"
+#include "rsa_key.h"
+#include "window.h"
+
+// ============================================================
+// RSA multi-premiers (RFC 8017 §3.2) : n = r_0 * r_1 * ... * r_(k-1)
+//   k = 2 à 4 facteurs de bits/k bits, tous distincts
+//   exposants       d_i = d mod (r_i - 1)
+//   coefficients    t_i = (r_0 * ... * r_(i-1))^(-1) mod r_i, t_0 = 1
+// Opération privée : k exponentiations de bits/k bits, puis
+// recombinaison de Garner
+//   y = m_0 ; y += (r_0 ... r_(i-1)) * (t_i * (m_i - y) mod r_i)
+// Une exponentiation coûte environ le cube de la taille du module, soit
+// k * (bits/k)^3 au total : en théorie 2,25x (k = 3) et 4x (k = 4) plus
+// rapide qu'avec deux facteurs (moins en pratique, la multiplication de
+// GMP étant sous-quadratique à ces tailles).
+// ============================================================
+
+// Génération de clé : primes, exps et coeffs reçoivent k éléments
+void keyGen_mp(unsigned long bits, unsigned int k, gmp_randclass& rng,
+               mpz_class& n, mpz_class& e, mpz_class& d,
+               std::vector<mpz_class>& primes,
+               std::vector<mpz_class>& exps,
+               std::vector<mpz_class>& coeffs);
+
+// parallel = true : les k exponentiations tournent sur k coeurs
+void dec_mp(std::string& m, const mpz_class& c,
+            const std::vector<mpz_class>& primes,
+            const std::vector<mpz_class>& exps,
+            const std::vector<mpz_class>& coeffs, bool parallel = false);
+
+void sing_mp(mpz_class& signature, const std::string& message,
+             const std::vector<mpz_class>& primes,
+             const std::vector<mpz_class>& exps,
+             const std::vector<mpz_class>& coeffs, bool parallel = false);
+
+// ------------------------------------------------------------
+// Clé multi-premiers précalculée (même rôle que RsaPrivateKey) :
+// contexte de Montgomery, découpe de d_i et t_i dans le domaine de
+// chaque facteur, produits partiels r_0 ... r_(i-1)
+// ------------------------------------------------------------
+class RsaMultiPrimeKey {
+public:
+    // exps et coeffs sont déduits de d et des facteurs
+    RsaMultiPrimeKey(const mpz_class& n, const mpz_class& e, const mpz_class& d,
+                     const std::vector<mpz_class>& primes);
+
+    const mpz_class& n() const { return pub_.n(); }
+    const mpz_class& e() const { return pub_.e(); }
+    const mpz_class& d() const { return d_; }
+    size_t count() const { return primes_.size(); }
+    const std::vector<mpz_class>& primes() const { return primes_; }
+    const std::vector<mpz_class>& exponents() const { return exps_; }
+    const std::vector<mpz_class>& coefficients() const { return coeffs_; }
+
+    const RsaPublicKey& public_key() const { return pub_; }
+
+    // Exponentiations privées à temps constant (voir RsaPrivateKey)
+    void set_constant_time(bool on) { consttime_ = on; }
+    bool constant_time() const { return consttime_; }
+
+    // x^d mod n ; parallel = true : une exponentiation par coeur
+    mpz_class pow(const mpz_class& x, bool parallel = false) const {
+        mpz_class r;
+        pow(r, x, parallel);
+        return r;
+    }
+    // En place (r peut être x), sans allocation sur un seul coeur
+    void pow(mpz_class& r, const mpz_class& x, bool parallel = false) const;
+
+private:
+    void pow_factor(mpz_class& r, const mpz_class& x, size_t i) const;
+    void garner(mpz_class& y, const mpz_class& mi, size_t i) const;
+
+    RsaPublicKey pub_;
+    mpz_class d_;
+    std::vector<mpz_class> primes_, exps_, coeffs_;
+    std::vector<MontgomeryContext> ctx_;
+    std::vector<ExpPlan> plans_;
+    std::vector<mpz_class> coeffs_m_;   // t_i * R mod r_i
+    std::vector<mpz_class> prefix_;     // r_0 * ... * r_(i-1)
+    bool consttime_ = false;
+};
+
+RsaMultiPrimeKey keyGen_mp(unsigned long bits, unsigned int k, gmp_randclass& rng);
+
+void dec_mp(std::string& m, const mpz_class& c, const RsaMultiPrimeKey& key,
+            bool parallel = false);
+
+void sing_mp(mpz_class& signature, const std::string& message,
+             const RsaMultiPrimeKey& key, bool parallel = false);
+
+#endif  // RSA_MP_H
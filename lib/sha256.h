@@ -0,0 +1,32 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================
+// SHA-256 (FIPS 180-4), calcul incrémental — empreinte des fichiers
+// signés par rsa_tool
+// ============================================================
+class Sha256 {
+public:
+    static const std::size_t DIGEST = 32;
+
+    Sha256();
+
+    void update(const std::byte* data, std::size_t len);
+    void finish(std::byte digest[DIGEST]);
+
+private:
+    void compress(const uint8_t* blocks, std::size_t nblocks);
+
+    uint32_t h_[8];
+    uint64_t total_ = 0;   // octets traités
+    uint8_t buf_[64];
+    unsigned buffered_ = 0;
+};
+
+// Empreinte d'un tampon en un appel
+void sha256(std::byte digest[Sha256::DIGEST], const std::byte* data, std::size_t len);
+
+#endif  // SHA256_H
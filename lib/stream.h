@@ -0,0 +1,79 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "rsa_key.h"
+
+// ============================================================
+// Chiffrement hybride en flux, pour des messages de taille quelconque
+//   - une clé de session aléatoire (256 bits) est chiffrée UNE fois
+//     par RSA (bourrage PKCS#1 v1.5 type 2)
+//   - le contenu est découpé en segments de 64 Kio, chacun chiffré et
+//     authentifié par ChaCha20-Poly1305 (construction STREAM : nonce =
+//     préfixe || numéro de segment || drapeau « dernier segment »),
+//     ce qui détecte réordonnancement et troncature
+//   - mémoire constante : update() ne garde au plus qu'un segment
+//
+// Format :  "RSAS" | version (1) | k (2, big-endian) | clé chiffrée (k)
+//           puis segments : chiffré (<= 64 Kio) | étiquette (16)
+// Le déchiffreur ne rend un segment qu'après vérification de son
+// étiquette ; une erreur lève runtime_error.
+// ============================================================
+
+class StreamEncryptor {
+public:
+    static const std::size_t SEGMENT = 64 * 1024;
+
+    explicit StreamEncryptor(const RsaPublicKey& key);
+
+    // Ajoute à out les segments complets (l'en-tête au premier appel)
+    void update(const std::byte* data, std::size_t len, std::vector<std::byte>& out);
+    // Scelle le dernier segment (éventuellement vide)
+    void finalize(std::vector<std::byte>& out);
+
+private:
+    void seal(bool last, std::vector<std::byte>& out);
+
+    std::vector<std::byte> header_;
+    std::byte key_[32];
+    std::byte prefix_[7];
+    uint32_t counter_ = 0;
+    std::vector<std::byte> buf_;
+    bool header_sent_ = false;
+    bool done_ = false;
+};
+
+class StreamDecryptor {
+public:
+    explicit StreamDecryptor(const RsaPrivateKey& key);
+
+    // Ajoute à out le clair des segments complets et authentifiés
+    void update(const std::byte* data, std::size_t len, std::vector<std::byte>& out);
+    // Dernier segment ; lève runtime_error si le flux est tronqué ou altéré
+    void finalize(std::vector<std::byte>& out);
+
+private:
+    void open(const std::byte* seg, std::size_t len, bool last, std::vector<std::byte>& out);
+    void unwrap();
+
+    RsaPrivateKey rsa_;
+    std::size_t k_ = 0;              // taille du module en octets
+    std::vector<std::byte> header_;
+    std::byte key_[32];
+    std::byte prefix_[7];
+    std::byte reject_[32];           // secret de rejet implicite (dérivé de d)
+    uint32_t counter_ = 0;
+    std::vector<std::byte> buf_;
+    bool have_key_ = false;
+    bool done_ = false;
+};
+
+// Fichier -> fichier, tampons de 64 Kio. En cas d'échec du déchiffrement
+// le fichier de sortie est supprimé.
+void encrypt_file(const std::string& in_path, const std::string& out_path, const RsaPublicKey& key);
+void decrypt_file(const std::string& in_path, const std::string& out_path, const RsaPrivateKey& key);
+
+#endif  // STREAM_H
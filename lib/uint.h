@@ -0,0 +1,398 @@
+#ifndef UINT_H
+#define UINT_H
+
+#include <gmpxx.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "window.h"
+
+// ============================================================
+// UInt<Bits> — entier non signé de taille fixe, sur la pile
+//   limb[0] = mot de poids faible, Bits/64 mots de 64 bits
+// Aucune allocation : les tailles de clé déployées (1024 à 4096 bits,
+// donc 512 à 2048 bits par facteur CRT) sont fixées à la compilation.
+// Les boucles portent sur une borne constante N : le compilateur les
+// déroule, et toutes les opérations de base sont constexpr.
+// ============================================================
+
+static_assert(GMP_LIMB_BITS == 64, "UInt suppose des mots GMP de 64 bits");
+
+using u128 = unsigned __int128;
+
+template <size_t Bits>
+struct UInt {
+    static_assert(Bits % 64 == 0, "Bits doit être un multiple de 64");
+    static constexpr size_t N = Bits / 64;
+
+    std::array<uint64_t, N> limb{};
+
+    constexpr UInt() = default;
+    constexpr UInt(uint64_t v) { limb[0] = v; }
+
+    constexpr bool bit(size_t i) const { return (limb[i / 64] >> (i % 64)) & 1; }
+
+    constexpr bool is_zero() const {
+        uint64_t acc = 0;
+        for (size_t i = 0; i < N; ++i) acc |= limb[i];
+        return acc == 0;
+    }
+
+    constexpr size_t bit_length() const {
+        for (size_t i = N; i-- > 0;) {
+            if (limb[i] != 0) return 64 * i + 64 - __builtin_clzll(limb[i]);
+        }
+        return 0;
+    }
+};
+
+using UInt512  = UInt<512>;
+using UInt1024 = UInt<1024>;
+using UInt1536 = UInt<1536>;
+using UInt2048 = UInt<2048>;
+using UInt3072 = UInt<3072>;
+using UInt4096 = UInt<4096>;
+
+// ------------------------------------------------------------
+// Opérations de base : +, -, comparaison, *, décalages
+// ------------------------------------------------------------
+
+// r = a + b, retourne la retenue sortante
+template <size_t B>
+constexpr uint64_t uint_add(UInt<B>& r, const UInt<B>& a, const UInt<B>& b) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < UInt<B>::N; ++i) {
+        u128 s = (u128)a.limb[i] + b.limb[i] + carry;
+        r.limb[i] = (uint64_t)s;
+        carry = (uint64_t)(s >> 64);
+    }
+    return carry;
+}
+
+// r = a - b, retourne l'emprunt sortant
+template <size_t B>
+constexpr uint64_t uint_sub(UInt<B>& r, const UInt<B>& a, const UInt<B>& b) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < UInt<B>::N; ++i) {
+        u128 d = (u128)a.limb[i] - b.limb[i] - borrow;
+        r.limb[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return borrow;
+}
+
+// -1, 0 ou 1 selon a < b, a == b, a > b
+template <size_t B>
+constexpr int uint_cmp(const UInt<B>& a, const UInt<B>& b) {
+    for (size_t i = UInt<B>::N; i-- > 0;) {
+        if (a.limb[i] != b.limb[i]) return a.limb[i] < b.limb[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// Produit complet sur 2*B bits
+//   À la compilation : multiplication scolaire ; à l'exécution :
+//   mpn_mul_n de GMP. Le noyau Karatsuba / Toom-3 de bench/mul.h n'est
+//   pas utilisé : de 8 à 32 mots (facteurs de 512 à 2048 bits), les
+//   routines assembleur de GMP vont environ deux fois plus vite, et
+//   seul mpn garde les moitiés UInt devant MontgomeryContext aux quatre
+//   tailles de CrtContext (bench_mul, bench_suite exp_half)
+template <size_t B>
+constexpr UInt<2 * B> uint_mul(const UInt<B>& a, const UInt<B>& b) {
+    constexpr size_t N = UInt<B>::N;
+    UInt<2 * B> r;
+    if (!__builtin_is_constant_evaluated()) {
+        mpn_mul_n(r.limb.data(), a.limb.data(), b.limb.data(), N);
+        return r;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < N; ++j) {
+            u128 t = (u128)a.limb[j] * b.limb[i] + r.limb[i + j] + carry;
+            r.limb[i + j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        r.limb[i + N] = carry;
+    }
+    return r;
+}
+
+// Carré sur 2*B bits : à l'exécution, mpn_sqr de GMP (produits croisés
+// calculés une seule fois)
+template <size_t B>
+constexpr UInt<2 * B> uint_sqr(const UInt<B>& a) {
+    if (__builtin_is_constant_evaluated()) return uint_mul(a, a);
+    UInt<2 * B> r;
+    mpn_sqr(r.limb.data(), a.limb.data(), UInt<B>::N);
+    return r;
+}
+
+// Décalage à droite de s bits (0 <= s < B)
+template <size_t B>
+constexpr UInt<B> uint_shr(const UInt<B>& a, size_t s) {
+    constexpr size_t N = UInt<B>::N;
+    UInt<B> r;
+    size_t w = s / 64, k = s % 64;
+    for (size_t i = 0; i + w < N; ++i) {
+        uint64_t lo = a.limb[i + w] >> k;
+        uint64_t hi = (k != 0 && i + w + 1 < N) ? a.limb[i + w + 1] << (64 - k) : 0;
+        r.limb[i] = lo | hi;
+    }
+    return r;
+}
+
+// Extension vers une taille supérieure (mots de poids fort à zéro)
+template <size_t To, size_t From>
+constexpr UInt<To> uint_widen(const UInt<From>& a) {
+    static_assert(To >= From, "uint_widen ne tronque pas");
+    UInt<To> r;
+    for (size_t i = 0; i < UInt<From>::N; ++i) r.limb[i] = a.limb[i];
+    return r;
+}
+
+// ------------------------------------------------------------
+// Conversions depuis / vers mpz_class (hors chemin critique)
+// ------------------------------------------------------------
+template <size_t B>
+UInt<B> uint_from_mpz(const mpz_class& x) {
+    UInt<B> r;
+    for (size_t i = 0; i < UInt<B>::N; ++i) r.limb[i] = mpz_getlimbn(x.get_mpz_t(), i);
+    return r;
+}
+
+template <size_t B>
+void uint_to_mpz(mpz_class& r, const UInt<B>& a) {
+    mpz_import(r.get_mpz_t(), UInt<B>::N, -1, sizeof(uint64_t), 0, 0, a.limb.data());
+}
+
+template <size_t B>
+mpz_class uint_to_mpz(const UInt<B>& a) {
+    mpz_class r;
+    uint_to_mpz(r, a);
+    return r;
+}
+
+// ============================================================
+// ============================================================
+// Montgomery sur UInt<B> — multiplication CIOS (Koç et al.)
+//   R = 2^B, n impair, n0inv = -n^(-1) mod 2^64
+// ============================================================
+template <size_t B>
+class UIntMontgomery {
+public:
+    static constexpr size_t N = UInt<B>::N;
+
+    constexpr explicit UIntMontgomery(const UInt<B>& n) : n_(n) {
+        // -n^(-1) mod 2^64 par Newton : 6 tours suffisent pour 64 bits
+        uint64_t x = 1;
+        for (int i = 0; i < 6; ++i) x = x * (2 - n.limb[0] * x);
+        n0inv_ = 0 - x;
+
+        // R mod n puis R^2 mod n par doublements successifs (addition seule)
+        UInt<B> r(1);
+        for (size_t i = 0; i < 2 * B; ++i) {
+            if (i == B) one_ = r;
+            uint64_t carry = uint_add(r, r, r);
+            if (carry || uint_cmp(r, n_) >= 0) uint_sub(r, r, n_);
+        }
+        r2_ = r;
+    }
+
+    constexpr const UInt<B>& modulus() const { return n_; }
+    constexpr const UInt<B>& one() const { return one_; }
+
+    // a*b*R^(-1) mod n, pour a, b < n
+    //   À l'exécution : produit complet (uint_mul) puis redc() ;
+    //   à la compilation : CIOS, produit et réduction entrelacés
+    constexpr UInt<B> mul(const UInt<B>& a, const UInt<B>& b) const {
+        if (!__builtin_is_constant_evaluated()) {
+            UInt<2 * B> t = uint_mul(a, b);
+            return redc(t);
+        }
+        uint64_t t[N + 2] = {};
+        for (size_t i = 0; i < N; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < N; ++j) {
+                u128 s = (u128)a.limb[j] * b.limb[i] + t[j] + carry;
+                t[j] = (uint64_t)s;
+                carry = (uint64_t)(s >> 64);
+            }
+            u128 s = (u128)t[N] + carry;
+            t[N] = (uint64_t)s;
+            t[N + 1] = (uint64_t)(s >> 64);
+
+            uint64_t m = t[0] * n0inv_;
+            s = (u128)m * n_.limb[0] + t[0];
+            carry = (uint64_t)(s >> 64);
+            for (size_t j = 1; j < N; ++j) {
+                s = (u128)m * n_.limb[j] + t[j] + carry;
+                t[j - 1] = (uint64_t)s;
+                carry = (uint64_t)(s >> 64);
+            }
+            s = (u128)t[N] + carry;
+            t[N - 1] = (uint64_t)s;
+            t[N] = t[N + 1] + (uint64_t)(s >> 64);
+        }
+
+        UInt<B> r;
+        for (size_t i = 0; i < N; ++i) r.limb[i] = t[i];
+        if (t[N] != 0 || uint_cmp(r, n_) >= 0) uint_sub(r, r, n_);
+        return r;
+    }
+
+    // a^2*R^(-1) mod n, pour a < n : carré complet (uint_sqr) puis
+    // réduction séparée (SOS), soit environ 1,5 N^2 produits de mots
+    // contre 2 N^2 pour mul(a, a)
+    constexpr UInt<B> sqr(const UInt<B>& a) const {
+        UInt<2 * B> t = uint_sqr(a);
+        return redc(t);
+    }
+
+    // t*R^(-1) mod n pour t < n*R (t est écrasé)
+    //   ligne i : t += m*n*2^(64i) avec m = t[i]*n0inv, qui annule t[i] ;
+    //   la retenue de la ligne est rangée dans t[i] et ajoutée en une
+    //   fois aux mots de poids fort à la fin. À l'exécution, chaque ligne
+    //   est un mpn_addmul_1 (boucle assembleur de GMP).
+    constexpr UInt<B> redc(UInt<2 * B>& t) const {
+        UInt<B> r;
+        uint64_t top = 0;
+        if (!__builtin_is_constant_evaluated()) {
+            uint64_t* tp = t.limb.data();
+            for (size_t i = 0; i < N; ++i) tp[i] = mpn_addmul_1(tp + i, n_.limb.data(), N, tp[i] * n0inv_);
+            top = mpn_add_n(r.limb.data(), tp + N, tp, N);
+        } else {
+            for (size_t i = 0; i < N; ++i) {
+                uint64_t m = t.limb[i] * n0inv_;
+                uint64_t carry = 0;
+                for (size_t j = 0; j < N; ++j) {
+                    u128 s = (u128)m * n_.limb[j] + t.limb[i + j] + carry;
+                    t.limb[i + j] = (uint64_t)s;
+                    carry = (uint64_t)(s >> 64);
+                }
+                // Retenue propagée sur le mot i+N ; le débordement au-delà
+                // de 2N mots est conservé dans top
+                u128 s = (u128)t.limb[i + N] + carry + top;
+                t.limb[i + N] = (uint64_t)s;
+                top = (uint64_t)(s >> 64);
+            }
+            for (size_t i = 0; i < N; ++i) r.limb[i] = t.limb[i + N];
+        }
+        if (top != 0 || uint_cmp(r, n_) >= 0) uint_sub(r, r, n_);
+        return r;
+    }
+
+    constexpr UInt<B> to_mont(const UInt<B>& a) const { return mul(a, r2_); }
+    constexpr UInt<B> from_mont(const UInt<B>& a) const { return mul(a, UInt<B>(1)); }
+
+    // base^e mod n par fenêtre fixe de 4 bits (base < n)
+    template <size_t EB>
+    constexpr UInt<B> exp(const UInt<B>& base, const UInt<EB>& e) const {
+        return from_mont(exp_mont(base, e));
+    }
+
+    // Même calcul, résultat laissé dans le domaine de Montgomery
+    template <size_t EB>
+    constexpr UInt<B> exp_mont(const UInt<B>& base, const UInt<EB>& e) const {
+        UInt<B> g[16];
+        g[0] = one_;
+        g[1] = to_mont(base);
+        for (int j = 2; j < 16; ++j) g[j] = mul(g[j - 1], g[1]);
+
+        UInt<B> result = one_;
+        size_t nbits = e.bit_length();
+        size_t top = (nbits + 3) / 4;
+        for (size_t k = top; k-- > 0;) {
+            for (int s = 0; s < 4; ++s) result = sqr(result);
+            unsigned idx = (unsigned)((e.limb[(4 * k) / 64] >> ((4 * k) % 64)) & 0xF);
+            if (idx != 0) result = mul(result, g[idx]);
+        }
+        return result;
+    }
+
+    // Fenêtres glissantes suivant un plan déjà découpé (window_plan),
+    // comme MontgomeryContext::exp_mont : table des 2^(w-1) puissances
+    // impaires sur la pile, résultat laissé dans le domaine (base < n)
+    UInt<B> exp_mont(const UInt<B>& base, const ExpPlan& plan) const {
+        int num_precomp = 1 << (plan.w - 1);
+        UInt<B> g[1 << (WINDOW_MAX - 1)];
+        g[0] = to_mont(base);
+        RSA_ADD(exp_multiplies, num_precomp > 1 ? num_precomp : 0);
+        if (num_precomp > 1) {
+            UInt<B> base2 = sqr(g[0]);
+            for (int j = 1; j < num_precomp; ++j) g[j] = mul(g[j - 1], base2);
+        }
+
+        UInt<B> result = one_;
+        for (const WindowStep& s : plan.steps) {
+            for (int j = 0; j < s.squarings; ++j) result = sqr(result);
+            RSA_ADD(exp_squarings, s.squarings);
+            if (s.index >= 0) {
+                result = mul(result, g[s.index]);
+                RSA_COUNT(exp_multiplies);
+            }
+        }
+        return result;
+    }
+
+    UInt<B> exp(const UInt<B>& base, const ExpPlan& plan) const {
+        return from_mont(exp_mont(base, plan));
+    }
+
+private:
+    UInt<B> n_;
+    UInt<B> one_;   // R mod n
+    UInt<B> r2_;    // R^2 mod n
+    uint64_t n0inv_ = 0;
+};
+
+// ------------------------------------------------------------
+// Recombinaison CRT (Garner) : m = m2 + q * (qinv * (m1 - m2) mod p)
+//   m1 < p, m2 < q, qinv = q^(-1) mod p, ctx_p construit sur p
+// ------------------------------------------------------------
+template <size_t B>
+constexpr UInt<2 * B> uint_crt(const UInt<B>& m1, const UInt<B>& m2,
+                               const UInt<B>& q, const UInt<B>& qinv,
+                               const UIntMontgomery<B>& ctx_p) {
+    const UInt<B>& p = ctx_p.modulus();
+    UInt<B> m2p = m2;
+    while (uint_cmp(m2p, p) >= 0) uint_sub(m2p, m2p, p);
+
+    UInt<B> diff;
+    if (uint_sub(diff, m1, m2p)) uint_add(diff, diff, p);   // (m1 - m2) mod p
+
+    // REDC(qinv*R * diff) = qinv * diff mod p
+    UInt<B> h = ctx_p.mul(ctx_p.to_mont(qinv), diff);
+
+    UInt<2 * B> m = uint_mul(q, h);
+    uint_add(m, m, uint_widen<2 * B>(m2));
+    return m;
+}
+
+// ------------------------------------------------------------
+// Miller–Rabin sur UInt<B> : n impair > 3, 1 < a < n-1
+// ------------------------------------------------------------
+template <size_t B>
+constexpr bool uint_miller_rabin(const UIntMontgomery<B>& ctx, const UInt<B>& a) {
+    const UInt<B>& n = ctx.modulus();
+    UInt<B> n_1;
+    uint_sub(n_1, n, UInt<B>(1));
+
+    size_t s = 0;
+    while (!n_1.bit(s)) ++s;
+    UInt<B> d = uint_shr(n_1, s);
+
+    // Tout le test reste dans le domaine : on compare à R et à -R mod n
+    UInt<B> one_m = ctx.one();
+    UInt<B> minus_one_m;
+    uint_sub(minus_one_m, n, one_m);
+
+    UInt<B> x = ctx.exp_mont(a, d);
+    if (uint_cmp(x, one_m) == 0 || uint_cmp(x, minus_one_m) == 0) return true;
+    for (size_t r = 1; r < s; ++r) {
+        x = ctx.sqr(x);
+        if (uint_cmp(x, minus_one_m) == 0) return true;
+    }
+    return false;
+}
+
+#endif  // UINT_H
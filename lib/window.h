@@ -0,0 +1,195 @@
+#ifndef WINDOW_H
+#define WINDOW_H
+
+#include <gmpxx.h>
+#include <vector>
+#include <algorithm>
+#include "arena.h"
+#include "instrument.h"
+
+// ============================================================
+// Exponentiation par fenêtres glissantes, en deux temps :
+//   1. window_plan : découpe de l'exposant en fenêtres (ne dépend que
+//      de l'exposant, donc calculable une fois par clé)
+//   2. apply_plan  : précalcul des puissances impaires de la base puis
+//      évaluation de gauche à droite en suivant le plan
+// ============================================================
+
+// Une étape : 'squarings' élévations au carré, puis une multiplication
+// par la puissance impaire g[index] (index = -1 : pas de multiplication)
+struct WindowStep {
+    int squarings;
+    int index;
+};
+
+struct ExpPlan {
+    int w = 4;
+    std::vector<WindowStep> steps;
+};
+
+// Largeur de fenêtre selon la taille de l'exposant : elle équilibre le
+// coût du précalcul (2^(w-1) produits) et le nombre de multiplications
+// restantes (~ bits / (w+1)). Plafonnée à 6 (exposants de 4096 bits).
+constexpr int WINDOW_MAX = 6;
+
+inline int window_bits(unsigned long exp_bits) {
+    if (exp_bits > 671) return WINDOW_MAX;
+    if (exp_bits > 239) return 5;
+    if (exp_bits > 79)  return 4;
+    if (exp_bits > 23)  return 3;
+    return 1;
+}
+
+// Nombre de bits en O(1) (0 pour un exposant nul ou négatif)
+inline unsigned long exp_bit_length(const mpz_class& exp) {
+    return exp > 0 ? mpz_sizeinbase(exp.get_mpz_t(), 2) : 0;
+}
+
+inline ExpPlan window_plan(const mpz_class& exp) {
+    ExpPlan plan;
+    int total_bits = (int)exp_bit_length(exp);
+    int w = plan.w = window_bits(total_bits);
+
+    auto bit = [&exp](int k) { return mpz_tstbit(exp.get_mpz_t(), k) ? 1 : 0; };
+
+    // Lecture de gauche à droite
+    int i = total_bits - 1;
+    while (i >= 0) {
+        int bit_i = bit(i);
+
+        if (bit_i == 0) {
+            plan.steps.push_back({1, -1});
+            i--;
+        } else {
+            // Une fenêtre glissante DOIT se terminer par un bit à 1 (être impair)
+            int l = std::max(0, i - w + 1);
+            while (bit(l) == 0) {
+                l++;
+            }
+
+            int window_value = 0;
+            for (int j = i; j >= l; j--) {
+                window_value = (window_value << 1) + bit(j);
+            }
+
+            // Seuls les impairs sont stockés : l'indice est window_value / 2
+            plan.steps.push_back({i - l + 1, window_value / 2});
+            i = l - 1;
+        }
+    }
+    return plan;
+}
+
+// Il ne connaît pas la réduction : mul(r, a, b) écrit dans r le produit
+// déjà réduit dans le domaine courant (classique avec modulo(), ou
+// Montgomery), r pouvant être a ou b ; g1 est la base réduite dans ce
+// domaine et one l'élément neutre. result ne doit pas être g1.
+// La table vient de l'arène du thread : aucune allocation par appel.
+template <typename Mul>
+void apply_plan(mpz_class& result, const mpz_class& g1, const ExpPlan& plan,
+                const mpz_class& one, Mul mul) {
+    ScratchArena::Frame frame;
+
+    // Le tableau stockera 2^(w-1) valeurs (uniquement les puissances impaires)
+    int num_precomp = 1 << (plan.w - 1);
+    mpz_class* g[1 << (WINDOW_MAX - 1)];
+
+    //  PHASE DE PRÉCALCUL : base^1, base^3, base^5, ...
+    g[0] = &frame.num();
+    *g[0] = g1;                      // base^1
+    RSA_ADD(exp_multiplies, num_precomp > 1 ? num_precomp : 0);
+    if (num_precomp > 1) {
+        mpz_class& base2 = frame.num();
+        mul(base2, g1, g1);          // base^2 (sert à sauter de 2 en 2)
+        for (int j = 1; j < num_precomp; j++) {
+            g[j] = &frame.num();
+            mul(*g[j], *g[j - 1], base2);
+        }
+    }
+
+    //  PHASE D'ÉVALUATION
+    result = one;
+    for (const WindowStep& s : plan.steps) {
+        for (int j = 0; j < s.squarings; j++) {
+            mul(result, result, result);
+        }
+        RSA_ADD(exp_squarings, s.squarings);
+        if (s.index >= 0) {
+            mul(result, result, *g[s.index]);
+            RSA_COUNT(exp_multiplies);
+        }
+    }
+}
+
+// ============================================================
+// Multi-exponentiation (Straus / Shamir) : prod g_i^(e_i) avec une seule
+// suite d'élévations au carré. Chaque exposant garde ses fenêtres
+// glissantes (window_plan), posées sur la position de leur bit de poids
+// faible ; à chaque position, un carré commun puis une multiplication
+// par fenêtre qui s'y termine (fenêtres entrelacées, Möller 2001).
+// Coût : max(bits) carrés au lieu de sum(bits).
+// ============================================================
+template <typename Mul>
+void apply_multi(mpz_class& result, const std::vector<mpz_class>& g1,
+                 const std::vector<mpz_class>& exps, const mpz_class& one, Mul mul) {
+    ScratchArena::Frame frame;
+    size_t k = g1.size();
+    unsigned long top = 0;
+    for (const auto& e : exps) top = std::max(top, exp_bit_length(e));
+
+    // digit[i][pos] : indice de la puissance impaire de la fenêtre de
+    // l'exposant i qui se termine au bit pos, -1 sinon
+    std::vector<std::vector<int>> digit(k, std::vector<int>(top, -1));
+    std::vector<std::vector<mpz_class*>> g(k);
+    for (size_t i = 0; i < k; ++i) {
+        ExpPlan plan = window_plan(exps[i]);
+        long pos = (long)exp_bit_length(exps[i]);
+        int max_index = 0;
+        for (const WindowStep& s : plan.steps) {
+            pos -= s.squarings;
+            if (s.index >= 0) {
+                digit[i][pos] = s.index;
+                max_index = std::max(max_index, s.index);
+            }
+        }
+
+        // Seules les puissances impaires réellement utilisées
+        g[i].resize(max_index + 1);
+        g[i][0] = &frame.num();
+        *g[i][0] = g1[i];
+        if (max_index > 0) {
+            mpz_class& base2 = frame.num();
+            mul(base2, g1[i], g1[i]);
+            for (int j = 1; j <= max_index; ++j) {
+                g[i][j] = &frame.num();
+                mul(*g[i][j], *g[i][j - 1], base2);
+            }
+            RSA_ADD(exp_multiplies, max_index + 1);
+        }
+    }
+
+    result = one;
+    bool started = false;
+    for (unsigned long pos = top; pos-- > 0;) {
+        if (started) {
+            mul(result, result, result);
+            RSA_COUNT(exp_squarings);
+        }
+        for (size_t i = 0; i < k; ++i) {
+            if (digit[i][pos] < 0) continue;
+            const mpz_class& f = *g[i][digit[i][pos]];
+            if (started) mul(result, result, f);
+            else result = f;
+            started = true;
+            RSA_COUNT(exp_multiplies);
+        }
+    }
+}
+
+template <typename Mul>
+void sliding_window(mpz_class& result, const mpz_class& g1, const mpz_class& exp,
+                    const mpz_class& one, Mul mul) {
+    apply_plan(result, g1, window_plan(exp), one, mul);
+}
+
+#endif  // WINDOW_H
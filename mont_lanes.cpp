@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "lib/arena.h"
+#include "lib/base.h"
+#include "lib/instrument.h"
+#include "lib/mont_lanes.h"
+#include "lib/window.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+using u128 = unsigned __int128;
+
+constexpr size_t L = MontLanes::LANES;
+constexpr uint64_t M52 = (1ull << 52) - 1;
+
+// ============================================================
+// Noyaux : r = a * b * R^(-1) mod n (presque réduit) sur les 8 voies
+//   a, b, n : m mots de 52 bits par voie ; r peut recouvrir a ou b
+//   T : 2m+2 mots par voie. L'itération i accumule a*b[i] puis q*n à
+//   partir de T[i] (q = T[i] * n0 mod 2^52 annule ses 52 bits bas), et
+//   reporte T[i] >> 52 sur T[i+1] : le résultat est T[m .. 2m).
+//   Les mots de T ne sont normalisés qu'à la fin : chacun reçoit au plus
+//   4(m+1) termes < 2^52, soit moins de 2^61 jusqu'à 8192 bits.
+// ============================================================
+using LaneMulFn = void (*)(uint64_t* r, const uint64_t* a, const uint64_t* b,
+                           const uint64_t* n, const uint64_t* n0, size_t m, uint64_t* T);
+
+void mul_portable(uint64_t* r, const uint64_t* a, const uint64_t* b,
+                  const uint64_t* n, const uint64_t* n0, size_t m, uint64_t* T) {
+    memset(T, 0, (2 * m + 2) * L * sizeof(uint64_t));
+    for (size_t i = 0; i < m; ++i) {
+        uint64_t* Ti = T + i * L;
+        const uint64_t* bi = b + i * L;
+        for (size_t j = 0; j < m; ++j) {
+            for (size_t l = 0; l < L; ++l) {
+                u128 p = (u128)a[j * L + l] * bi[l];
+                Ti[j * L + l] += (uint64_t)p & M52;
+                Ti[(j + 1) * L + l] += (uint64_t)(p >> 52);
+            }
+        }
+        uint64_t q[L];
+        for (size_t l = 0; l < L; ++l) q[l] = (Ti[l] * n0[l]) & M52;
+        for (size_t j = 0; j < m; ++j) {
+            for (size_t l = 0; l < L; ++l) {
+                u128 p = (u128)n[j * L + l] * q[l];
+                Ti[j * L + l] += (uint64_t)p & M52;
+                Ti[(j + 1) * L + l] += (uint64_t)(p >> 52);
+            }
+        }
+        for (size_t l = 0; l < L; ++l) Ti[L + l] += Ti[l] >> 52;
+    }
+    for (size_t l = 0; l < L; ++l) {
+        uint64_t c = 0;
+        for (size_t j = 0; j < m; ++j) {
+            uint64_t v = T[(m + j) * L + l] + c;
+            r[j * L + l] = v & M52;
+            c = v >> 52;
+        }
+    }
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("avx512f,avx512ifma")))
+void mul_ifma(uint64_t* r, const uint64_t* a, const uint64_t* b,
+              const uint64_t* n, const uint64_t* n0, size_t m, uint64_t* T) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i mask = _mm512_set1_epi64((long long)M52);
+    const __m512i vn0 = _mm512_loadu_si512(n0);
+    __m512i* t = reinterpret_cast<__m512i*>(T);
+    for (size_t j = 0; j < 2 * m + 2; ++j) _mm512_storeu_si512(t + j, zero);
+
+    for (size_t i = 0; i < m; ++i) {
+        __m512i* ti = t + i;
+        const __m512i bi = _mm512_loadu_si512(b + i * L);
+        for (size_t j = 0; j < m; ++j) {
+            const __m512i aj = _mm512_loadu_si512(a + j * L);
+            _mm512_storeu_si512(ti + j, _mm512_madd52lo_epu64(_mm512_loadu_si512(ti + j), aj, bi));
+            _mm512_storeu_si512(ti + j + 1, _mm512_madd52hi_epu64(_mm512_loadu_si512(ti + j + 1), aj, bi));
+        }
+        const __m512i q = _mm512_madd52lo_epu64(zero, _mm512_loadu_si512(ti), vn0);
+        for (size_t j = 0; j < m; ++j) {
+            const __m512i nj = _mm512_loadu_si512(n + j * L);
+            _mm512_storeu_si512(ti + j, _mm512_madd52lo_epu64(_mm512_loadu_si512(ti + j), nj, q));
+            _mm512_storeu_si512(ti + j + 1, _mm512_madd52hi_epu64(_mm512_loadu_si512(ti + j + 1), nj, q));
+        }
+        __m512i carry = _mm512_maskz_srli_epi64(0xFF, _mm512_loadu_si512(ti), 52);
+        _mm512_storeu_si512(ti + 1, _mm512_add_epi64(_mm512_loadu_si512(ti + 1), carry));
+    }
+
+    __m512i c = zero;
+    for (size_t j = 0; j < m; ++j) {
+        __m512i v = _mm512_add_epi64(_mm512_loadu_si512(t + m + j), c);
+        _mm512_storeu_si512(r + j * L, _mm512_and_si512(v, mask));
+        c = _mm512_maskz_srli_epi64(0xFF, v, 52);
+    }
+}
+
+// Produit 52x52 -> (lo, hi) sur 4 voies : a = a1 2^26 + a0, b = b1 2^26 + b0
+__attribute__((target("avx2")))
+inline void mul52_avx2(__m256i a, __m256i b, __m256i& lo, __m256i& hi) {
+    const __m256i m26 = _mm256_set1_epi64x((1ll << 26) - 1);
+    const __m256i m52 = _mm256_set1_epi64x((long long)M52);
+    __m256i a0 = _mm256_and_si256(a, m26), a1 = _mm256_srli_epi64(a, 26);
+    __m256i b0 = _mm256_and_si256(b, m26), b1 = _mm256_srli_epi64(b, 26);
+    __m256i mid = _mm256_add_epi64(_mm256_mul_epu32(a0, b1), _mm256_mul_epu32(a1, b0));
+    __m256i low = _mm256_add_epi64(_mm256_mul_epu32(a0, b0),
+                                   _mm256_slli_epi64(_mm256_and_si256(mid, m26), 26));
+    lo = _mm256_and_si256(low, m52);
+    hi = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(a1, b1), _mm256_srli_epi64(mid, 26)),
+                          _mm256_srli_epi64(low, 52));
+}
+
+__attribute__((target("avx2")))
+inline __m256i load4(const uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+__attribute__((target("avx2")))
+inline void store4(uint64_t* p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+// Deux moitiés de 4 voies traitées l'une après l'autre (h = 0, 4)
+__attribute__((target("avx2")))
+void mul_avx2(uint64_t* r, const uint64_t* a, const uint64_t* b,
+              const uint64_t* n, const uint64_t* n0, size_t m, uint64_t* T) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask = _mm256_set1_epi64x((long long)M52);
+    for (size_t h = 0; h < L; h += 4) {
+        for (size_t j = 0; j < 2 * m + 2; ++j) store4(T + j * L + h, zero);
+
+        const __m256i vn0 = load4(n0 + h);
+        __m256i lo, hi, q;
+        for (size_t i = 0; i < m; ++i) {
+            uint64_t* Ti = T + i * L + h;
+            const __m256i bi = load4(b + i * L + h);
+            for (size_t j = 0; j < m; ++j) {
+                mul52_avx2(load4(a + j * L + h), bi, lo, hi);
+                store4(Ti + j * L, _mm256_add_epi64(load4(Ti + j * L), lo));
+                store4(Ti + (j + 1) * L, _mm256_add_epi64(load4(Ti + (j + 1) * L), hi));
+            }
+            mul52_avx2(_mm256_and_si256(load4(Ti), mask), vn0, q, hi);
+            for (size_t j = 0; j < m; ++j) {
+                mul52_avx2(load4(n + j * L + h), q, lo, hi);
+                store4(Ti + j * L, _mm256_add_epi64(load4(Ti + j * L), lo));
+                store4(Ti + (j + 1) * L, _mm256_add_epi64(load4(Ti + (j + 1) * L), hi));
+            }
+            store4(Ti + L, _mm256_add_epi64(load4(Ti + L), _mm256_srli_epi64(load4(Ti), 52)));
+        }
+
+        __m256i c = zero;
+        for (size_t j = 0; j < m; ++j) {
+            __m256i v = _mm256_add_epi64(load4(T + (m + j) * L + h), c);
+            store4(r + j * L + h, _mm256_and_si256(v, mask));
+            c = _mm256_srli_epi64(v, 52);
+        }
+    }
+}
+
+#endif  // __x86_64__
+
+// ------------------------------------------------------------
+// Choix du noyau
+// ------------------------------------------------------------
+struct Kernel {
+    const char* name;
+    LaneMulFn fn;
+};
+
+Kernel detect_kernel() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512ifma")) return {"avx512ifma", mul_ifma};
+    if (__builtin_cpu_supports("avx2")) return {"avx2", mul_avx2};
+#endif
+    return {"portable", mul_portable};
+}
+
+Kernel& current_kernel() {
+    static Kernel k = detect_kernel();
+    return k;
+}
+
+// ------------------------------------------------------------
+// Conversions mpz <-> base 2^52 : m mots espacés de stride (1 pour un
+// tableau simple, LANES pour une voie d'un tableau entrelacé)
+// ------------------------------------------------------------
+void to52(uint64_t* out, size_t stride, const mpz_class& x, size_t m) {
+    for (size_t j = 0; j < m; ++j) {
+        size_t bit = 52 * j, w = bit / 64, s = bit % 64;
+        uint64_t v = mpz_getlimbn(x.get_mpz_t(), w) >> s;
+        if (s > 12) v |= mpz_getlimbn(x.get_mpz_t(), w + 1) << (64 - s);
+        out[j * stride] = v & M52;
+    }
+}
+
+// Écrit directement dans les mots de r (pas de tampon intermédiaire)
+void from52(mpz_class& r, const uint64_t* in, size_t stride, size_t m) {
+    size_t nw = (52 * m + 63) / 64 + 1;
+    mp_limb_t* words = mpz_limbs_write(r.get_mpz_t(), nw);
+    memset(words, 0, nw * sizeof(mp_limb_t));
+    for (size_t j = 0; j < m; ++j) {
+        size_t bit = 52 * j, w = bit / 64, s = bit % 64;
+        uint64_t v = in[j * stride];
+        words[w] |= v << s;
+        if (s > 12) words[w + 1] |= v >> (64 - s);
+    }
+    mpz_limbs_finish(r.get_mpz_t(), nw);
+}
+
+}  // namespace
+
+// ============================================================
+// LaneModulus
+// ============================================================
+LaneModulus::LaneModulus(const mpz_class& n) : n_(n) {
+    if (n <= 1 || (n & 1) == 0) throw runtime_error("LaneModulus: module impair > 1 requis");
+    m_ = (mpz_sizeinbase(n.get_mpz_t(), 2) + 2 + 51) / 52;
+
+    // -n^(-1) mod 2^52 par Newton sur 64 bits
+    uint64_t n0 = mpz_getlimbn(n.get_mpz_t(), 0), x = 1;
+    for (int i = 0; i < 6; ++i) x *= 2 - n0 * x;
+    n0_ = (0 - x) & M52;
+
+    mpz_class one = modulo(mpz_class(1) << (52 * m_), n);
+    mpz_class r2 = modulo(one * one, n);
+
+    n52_.resize(m_);
+    one_.resize(m_);
+    r2_.resize(m_);
+    to52(n52_.data(), 1, n, m_);
+    to52(one_.data(), 1, one, m_);
+    to52(r2_.data(), 1, r2, m_);
+}
+
+// ============================================================
+// MontLanes
+// ============================================================
+MontLanes::MontLanes(const vector<const LaneModulus*>& moduli) : used_(moduli.size()) {
+    if (used_ == 0 || used_ > LANES) throw runtime_error("MontLanes: 1 à 8 modules");
+    m_ = moduli[0]->limbs();
+    for (const LaneModulus* mod : moduli) {
+        if (mod->limbs() != m_) throw runtime_error("MontLanes: modules de tailles différentes");
+    }
+
+    n_.resize(m_ * LANES);
+    one_.resize(m_ * LANES);
+    r2_.resize(m_ * LANES);
+    n0_.resize(LANES);
+    for (size_t l = 0; l < LANES; ++l) {
+        const LaneModulus& mod = *moduli[l < used_ ? l : 0];
+        if (l < used_) mod_.push_back(mod.n_);
+        n0_[l] = mod.n0_;
+        for (size_t j = 0; j < m_; ++j) {
+            n_[j * LANES + l] = mod.n52_[j];
+            one_[j * LANES + l] = mod.one_[j];
+            r2_[j * LANES + l] = mod.r2_[j];
+        }
+    }
+}
+
+void MontLanes::exp(vector<mpz_class>& r, const vector<mpz_class>& bases,
+                    const vector<mpz_class>& exps) const {
+    if (bases.size() != used_ || exps.size() != used_) {
+        throw runtime_error("MontLanes::exp: une base et un exposant par module");
+    }
+    r.resize(used_);
+    mpz_class* out[LANES];
+    const mpz_class* b[LANES];
+    const mpz_class* e[LANES];
+    for (size_t l = 0; l < used_; ++l) {
+        out[l] = &r[l];
+        b[l] = &bases[l];
+        e[l] = &exps[l];
+    }
+    exp(out, b, e);
+}
+
+void MontLanes::exp(mpz_class* const* r, const mpz_class* const* bases,
+                    const mpz_class* const* exps) const {
+    RSA_TIMED(exp);
+    const LaneMulFn mul = current_kernel().fn;
+    const size_t W = m_ * LANES;
+
+    bool same = true;
+    unsigned long maxbits = 0;
+    for (size_t l = 0; l < used_; ++l) {
+        same = same && *exps[l] == *exps[0];
+        maxbits = max(maxbits, exp_bit_length(*exps[l]));
+    }
+    int w = same ? window_bits(maxbits) : min(window_bits(maxbits), 5);
+    size_t entries = same ? (size_t(1) << (w - 1)) : (size_t(1) << w);
+
+    // Table, x, acc, tmp et T dans l'arène du thread
+    ScratchArena::Frame frame;
+    size_t words = (entries + 3) * W + (2 * m_ + 2) * LANES;
+    uint64_t* table = frame.limbs(words);
+    memset(table, 0, words * sizeof(uint64_t));
+    uint64_t* x = table + entries * W;
+    uint64_t* acc = x + W;
+    uint64_t* tmp = acc + W;
+    uint64_t* T = tmp + W;
+
+    // Entrée dans le domaine : x = base * R^2 * R^(-1)
+    for (size_t l = 0; l < used_; ++l) to52(x + l, LANES, *bases[l], m_);
+    mul(x, x, r2_.data(), n_.data(), n0_.data(), m_, T);
+    memcpy(acc, one_.data(), W * sizeof(uint64_t));
+
+    if (same) {
+        // Même plan pour toutes les voies : fenêtre glissante commune
+        ExpPlan plan = window_plan(*exps[0]);
+        memcpy(table, x, W * sizeof(uint64_t));
+        if (entries > 1) {
+            mul(tmp, x, x, n_.data(), n0_.data(), m_, T);
+            for (size_t j = 1; j < entries; ++j) {
+                mul(table + j * W, table + (j - 1) * W, tmp, n_.data(), n0_.data(), m_, T);
+            }
+        }
+        for (const WindowStep& s : plan.steps) {
+            for (int j = 0; j < s.squarings; ++j) mul(acc, acc, acc, n_.data(), n0_.data(), m_, T);
+            RSA_ADD(exp_squarings, s.squarings);
+            if (s.index >= 0) {
+                mul(acc, acc, table + s.index * W, n_.data(), n0_.data(), m_, T);
+                RSA_COUNT(exp_multiplies);
+            }
+        }
+    } else {
+        // Fenêtre fixe : table[k] = x^k, un chiffre par voie et par fenêtre
+        memcpy(table, one_.data(), W * sizeof(uint64_t));
+        memcpy(table + W, x, W * sizeof(uint64_t));
+        for (size_t k = 2; k < entries; ++k) {
+            mul(table + k * W, table + (k - 1) * W, x, n_.data(), n0_.data(), m_, T);
+        }
+        size_t windows = (maxbits + w - 1) / w;
+        for (size_t k = windows; k-- > 0;) {
+            if (k + 1 != windows) {
+                for (int j = 0; j < w; ++j) mul(acc, acc, acc, n_.data(), n0_.data(), m_, T);
+                RSA_ADD(exp_squarings, w);
+            }
+            for (size_t l = 0; l < LANES; ++l) {
+                size_t d = 0;
+                if (l < used_) {
+                    for (int b = w - 1; b >= 0; --b) {
+                        d = (d << 1) | (size_t)mpz_tstbit(exps[l]->get_mpz_t(), k * w + b);
+                    }
+                }
+                const uint64_t* src = table + d * W;
+                for (size_t j = 0; j < m_; ++j) tmp[j * LANES + l] = src[j * LANES + l];
+            }
+            mul(acc, acc, tmp, n_.data(), n0_.data(), m_, T);
+            RSA_COUNT(exp_multiplies);
+        }
+    }
+
+    // Sortie du domaine : REDC(acc * 1) <= n, égal à n seulement pour 0
+    memset(tmp, 0, W * sizeof(uint64_t));
+    for (size_t l = 0; l < LANES; ++l) tmp[l] = 1;
+    mul(acc, acc, tmp, n_.data(), n0_.data(), m_, T);
+
+    for (size_t l = 0; l < used_; ++l) {
+        from52(*r[l], acc + l, LANES, m_);
+        if (*r[l] >= mod_[l]) mpz_sub(r[l]->get_mpz_t(), r[l]->get_mpz_t(), mod_[l].get_mpz_t());
+    }
+}
+
+const char* MontLanes::kernel() { return current_kernel().name; }
+
+bool MontLanes::select_kernel(const char* name) {
+    string s = name;
+    if (s == "portable") {
+        current_kernel() = {"portable", mul_portable};
+        return true;
+    }
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (s == "avx2" && __builtin_cpu_supports("avx2")) {
+        current_kernel() = {"avx2", mul_avx2};
+        return true;
+    }
+    if (s == "avx512ifma" && __builtin_cpu_supports("avx512ifma")) {
+        current_kernel() = {"avx512ifma", mul_ifma};
+        return true;
+    }
+#endif
+    return false;
+}
+
+// Seuils relevés avec bench_suite face à MontgomeryContext::exp (une
+// exponentiation par module) : les voies inutilisées coûtent autant que
+// les autres, et le noyau avx2 ne gagne qu'avec les 8 voies pleines
+bool MontLanes::profitable(size_t bits, size_t count) {
+    LaneMulFn fn = current_kernel().fn;
+    if (fn == mul_ifma) return count >= 3 || bits <= 1024;
+    if (fn == mul_avx2) return count >= 6 && bits <= 1024;
+    return false;
+}
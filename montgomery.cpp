@@ -0,0 +1,198 @@
+#include <cstring>
+#include <vector>
+#include "lib/arena.h"
+#include "lib/montgomery.h"
+#include "lib/window.h"
+
+using namespace std;
+
+namespace {
+
+// Table de puissances "dispersée" : le mot j de l'entrée i est rangé en
+// j*T + i. Une lecture parcourt toutes les entrées pour chaque mot et ne
+// garde la bonne que par masquage : la suite d'adresses lues (donc les
+// lignes de cache touchées) ne dépend pas de l'indice secret.
+// Les entries * limbs mots sont fournis par l'appelant (arène).
+class ScatterTable {
+public:
+    ScatterTable(mp_limb_t* data, size_t entries, size_t limbs)
+        : T_(entries), K_(limbs), data_(data) {
+        memset(data_, 0, entries * limbs * sizeof(mp_limb_t));
+    }
+
+    void scatter(size_t i, const mpz_class& x) {
+        for (size_t j = 0; j < K_; ++j) data_[j * T_ + i] = mpz_getlimbn(x.get_mpz_t(), j);
+    }
+
+    void gather(mpz_class& x, size_t idx) const {
+        mp_limb_t* out = mpz_limbs_write(x.get_mpz_t(), K_);
+        for (size_t j = 0; j < K_; ++j) {
+            const mp_limb_t* row = &data_[j * T_];
+            mp_limb_t acc = 0;
+            for (size_t i = 0; i < T_; ++i) {
+                mp_limb_t mask = (mp_limb_t)0 - (mp_limb_t)(i == idx);
+                acc |= row[i] & mask;
+            }
+            out[j] = acc;
+        }
+        mpz_limbs_finish(x.get_mpz_t(), K_);
+    }
+
+private:
+    size_t T_, K_;
+    mp_limb_t* data_;
+};
+
+}  // namespace
+
+MontgomeryContext::MontgomeryContext(const mpz_class& n) : n_(n) {
+    // k = nombre de bits de n arrondi au mot de 64 bits supérieur
+    unsigned long nbits = mpz_sizeinbase(n.get_mpz_t(), 2);
+    k_ = ((nbits + 63) / 64) * 64;
+
+    mpz_class R = mpz_class(1) << k_;
+    mask_ = R - 1;
+
+    // Inverse de n modulo R par itération de Newton (Hensel) :
+    //   x <- x * (2 - n*x)  double la précision à chaque tour.
+    // x = 1 est correct modulo 2 car n est impair.
+    mpz_class x = 1;
+    for (unsigned long prec = 1; prec < k_; prec = prec + prec) {
+        x = (x * (2 - ((n * x) & mask_))) & mask_;
+    }
+    n_prime_ = (R - x) & mask_;   // -n^(-1) mod R
+
+    // Constantes de conversion : calculées une seule fois
+    one_ = modulo(R, n);
+    R2_  = modulo(one_ * one_, n);
+    R3_  = redc(R2_ * R2_);        // R^4 * R^(-1)
+    bound_ = n * R;
+}
+
+// REDC sur les entiers de l'arène : m = (T mod R) * n' mod R, puis
+// (T + m*n) / R, divisible par R
+void MontgomeryContext::redc(mpz_class& r, const mpz_class& T) const {
+    ScratchArena::Frame frame;
+    mpz_class& m = frame.num();
+    mpz_class& t = frame.num();
+    mpz_tdiv_r_2exp(m.get_mpz_t(), T.get_mpz_t(), k_);
+    mpz_mul(m.get_mpz_t(), m.get_mpz_t(), n_prime_.get_mpz_t());
+    mpz_tdiv_r_2exp(m.get_mpz_t(), m.get_mpz_t(), k_);
+    mpz_mul(t.get_mpz_t(), m.get_mpz_t(), n_.get_mpz_t());
+    mpz_add(t.get_mpz_t(), t.get_mpz_t(), T.get_mpz_t());
+    mpz_tdiv_q_2exp(r.get_mpz_t(), t.get_mpz_t(), k_);
+    if (r >= n_) mpz_sub(r.get_mpz_t(), r.get_mpz_t(), n_.get_mpz_t());
+}
+
+void MontgomeryContext::mul(mpz_class& r, const mpz_class& a, const mpz_class& b) const {
+    ScratchArena::Frame frame;
+    mpz_class& T = frame.num();
+    mpz_mul(T.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
+    redc(r, T);
+}
+
+mpz_class MontgomeryContext::exp(const mpz_class& base, const mpz_class& exp) const {
+    return this->exp(base, window_plan(exp));
+}
+
+void MontgomeryContext::enter(mpz_class& r, const mpz_class& base) const {
+    if (base < 0) {
+        r = to_mont(modulo(base, n_));
+        return;
+    }
+
+    // Au-delà de n*R (base modulo un produit de plusieurs facteurs) :
+    // chaque repliement base = h*R + l -> h + REDC(l) divise par R modulo n,
+    // corrigé ensuite par autant de multiplications par R
+    ScratchArena::Frame frame;
+    mpz_class& t = frame.num();
+    mpz_class& l = frame.num();
+    const mpz_class* x = &base;
+    unsigned folds = 0;
+    if (base >= bound_) {
+        t = base;
+        while (t >= bound_) {
+            mpz_tdiv_r_2exp(l.get_mpz_t(), t.get_mpz_t(), k_);
+            redc(l, l);
+            mpz_tdiv_q_2exp(t.get_mpz_t(), t.get_mpz_t(), k_);
+            t += l;
+            ++folds;
+        }
+        x = &t;
+    }
+    redc(l, *x);          // to_mont_reduce
+    mul(r, l, R3_);
+    for (; folds > 0; --folds) mul(r, r, R2_);
+}
+
+void MontgomeryContext::exp_mont(mpz_class& r, const mpz_class& base, const ExpPlan& plan) const {
+    ScratchArena::Frame frame(k_);
+    mpz_class& g1 = frame.num();
+    enter(g1, base);
+    apply_plan(r, g1, plan, one_,
+        [this](mpz_class& x, const mpz_class& a, const mpz_class& b) { mul(x, a, b); });
+}
+
+void MontgomeryContext::exp(mpz_class& r, const mpz_class& base, const ExpPlan& plan) const {
+    exp_mont(r, base, plan);
+    redc(r, r);
+}
+
+mpz_class MontgomeryContext::multi_exp(const vector<mpz_class>& bases,
+                                       const vector<mpz_class>& exps) const {
+    vector<mpz_class> g1(bases.size());
+    for (size_t i = 0; i < bases.size(); ++i) enter(g1[i], bases[i]);
+    mpz_class r;
+    apply_multi(r, g1, exps, one_,
+        [this](mpz_class& x, const mpz_class& a, const mpz_class& b) { mul(x, a, b); });
+    redc(r, r);
+    return r;
+}
+
+void MontgomeryContext::exp_consttime(mpz_class& r, const mpz_class& base,
+                                      const mpz_class& exp) const {
+    // Longueur publique : celle du module (dp < p, d < n), sauf exposant plus long
+    unsigned long nbits = max<unsigned long>(mpz_sizeinbase(n_.get_mpz_t(), 2), exp_bit_length(exp));
+    int w = window_bits(nbits);
+    size_t entries = size_t(1) << w;
+
+    // Toutes les puissances base^0 .. base^(2^w - 1), y compris les paires
+    ScratchArena::Frame frame(k_);
+    ScatterTable table(frame.limbs(entries * (k_ / 64)), entries, k_ / 64);
+    mpz_class& g1 = frame.num();
+    mpz_class& x = frame.num();
+    mpz_class& t = frame.num();
+    enter(g1, base);
+    x = one_;
+    for (size_t i = 0; i < entries; ++i) {
+        table.scatter(i, x);
+        mul(x, x, g1);
+    }
+
+    unsigned long windows = (nbits + w - 1) / w;
+    r = one_;
+    for (unsigned long k = windows; k-- > 0;) {
+        for (int s = 0; s < w; ++s) mul(r, r, r);
+
+        size_t idx = 0;
+        for (int b = w - 1; b >= 0; --b) {
+            idx = (idx << 1) | (size_t)mpz_tstbit(exp.get_mpz_t(), k * w + b);
+        }
+        table.gather(t, idx);
+        mul(r, r, t);   // même pour idx = 0 (multiplication par 1)
+    }
+    redc(r, r);
+}
+
+// 65537 = 2^16 + 1
+mpz_class MontgomeryContext::exp_65537(const mpz_class& base) const {
+    ScratchArena::Frame frame(k_);
+    mpz_class& g1 = frame.num();
+    mpz_class& r = frame.num();
+    enter(g1, base);
+    mul(r, g1, g1);
+    for (int i = 1; i < 16; ++i) mul(r, r, r);
+    mul(r, r, g1);
+    redc(r, r);
+    return r;
+}
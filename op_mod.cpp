@@ -1,36 +1,142 @@
 #include "lib/op_mod.h"
+#include "lib/arena.h"
+#include "lib/barrett.h"
+#include "lib/instrument.h"
+
+using namespace std;
 
 
 
 mpz_class mulmod(const mpz_class& A, const mpz_class& B, const mpz_class& n) {
+    RSA_TIMED(mulmod);
     mpz_class a = modulo(A, n);
     mpz_class b = modulo(B, n);
     mpz_class prod = a * b;
     return modulo(prod, n);
 }
 
-// Algorithme d'Euclide étendu : retourne le pgcd de A et B ainsi que les coefficients de Bezout x et y tels que  A*x + B*y = pgcd(A, B).
-std::tuple<mpz_class, mpz_class, mpz_class> extended_gcd(mpz_class A, mpz_class B) {
-    mpz_class x0 = 1, y0 = 0;
-    mpz_class x1 = 0, y1 = 1;
+mpz_class mulmod(const mpz_class& A, const mpz_class& B, const BarrettContext& ctx) {
+    RSA_TIMED(mulmod);
+    const mpz_class& n = ctx.modulus();
+    // Les opérandes déjà dans [0, n) ne sont pas réduites une deuxième fois
+    mpz_class a = (A >= 0 && A < n) ? A : ctx.reduce(A);
+    mpz_class b = (B >= 0 && B < n) ? B : ctx.reduce(B);
+    return ctx.reduce(a * b);
+}
+
+// ============================================================
+// Euclide étendu de Lehmer
+//   Tant que les nombres sont grands, on ne regarde que leurs 62 bits de
+//   poids fort : sur ces mots, les quotients successifs sont calculés en
+//   simple précision et cumulés dans une matrice de cofacteurs (a b; c d).
+//   Les grands entiers (et les coefficients de Bezout) ne sont mis à jour
+//   qu'une fois par série de pas : u <- a*u + b*v, v <- c*u + d*v.
+//   Si aucun pas n'est sûr, on fait un pas complet avec division_euclidienne.
+//   Tous les entiers de travail viennent de l'arène du thread : une
+//   itération ne fait aucune allocation.
+// ============================================================
+
+// r = a*u + b*v (r distinct de u et v)
+static void combine(mpz_class& r, long a, const mpz_class& u, long b, const mpz_class& v) {
+    mpz_mul_si(r.get_mpz_t(), u.get_mpz_t(), a);
+    if (b >= 0) mpz_addmul_ui(r.get_mpz_t(), v.get_mpz_t(), (unsigned long)b);
+    else        mpz_submul_ui(r.get_mpz_t(), v.get_mpz_t(), -(unsigned long)b);
+}
 
-    while (B != 0) {
-        mpz_class q = quotient(A, B);
-        mpz_class r = A - q * B;
+// Pas de la matrice (a b; c d) sur le couple (u, v), t sert de temporaire
+static void apply(mpz_class& u, mpz_class& v, mpz_class& t, long a, long b, long c, long d) {
+    combine(t, a, u, b, v);
+    combine(u, c, u, d, v);   // u reçoit c*u + d*v : mpz_mul_si accepte u en sortie
+    mpz_swap(u.get_mpz_t(), v.get_mpz_t());
+    mpz_swap(u.get_mpz_t(), t.get_mpz_t());
+}
+
+// A, B >= 0 ; x et y (si non nuls) reçoivent les coefficients de Bezout
+static mpz_class lehmer(const mpz_class& A, const mpz_class& B, mpz_class* x, mpz_class* y) {
+    ScratchArena::Frame frame(max(mpz_sizeinbase(A.get_mpz_t(), 2), mpz_sizeinbase(B.get_mpz_t(), 2)));
+    mpz_class& u = frame.num();
+    mpz_class& v = frame.num();
+    // u = xu*A + yu*B  et  v = xv*A + yv*B
+    mpz_class& xu = frame.num();
+    mpz_class& yu = frame.num();
+    mpz_class& xv = frame.num();
+    mpz_class& yv = frame.num();
+    mpz_class& t = frame.num();
+    mpz_class& r = frame.num();
+    mpz_class& q = frame.num();
+    bool coeffs = x != nullptr;
+    u = A;
+    v = B;
+    xu = 1; yu = 0; xv = 0; yv = 1;
+    bool swapped = false;
+    if (u < v) {
+        mpz_swap(u.get_mpz_t(), v.get_mpz_t());
+        swapped = true;
+    }
 
-        A = B;
-        B = r;
+    RSA_COUNT(gcd_calls);
+    while (v != 0) {
+        RSA_COUNT(gcd_iterations);
+        unsigned long nbits = mpz_sizeinbase(u.get_mpz_t(), 2);
+        unsigned long shift = nbits > 62 ? nbits - 62 : 0;
+        t = u >> shift;
+        long uh = t.get_si();
+        t = v >> shift;
+        long vh = t.get_si();
 
-        mpz_class x_temp = x0 - q * x1;
-        x0 = x1;
-        x1 = x_temp;
+        long a = 1, b = 0, c = 0, d = 1;
+        while (vh + c != 0 && vh + d != 0) {
+            long q1 = (uh + a) / (vh + c);
+            long q2 = (uh + b) / (vh + d);
+            if (q1 != q2) break;
+
+            long tmp = a - q1 * c; a = c; c = tmp;
+            tmp = b - q1 * d; b = d; d = tmp;
+            tmp = uh - q1 * vh; uh = vh; vh = tmp;
+        }
+
+        if (b == 0) {
+            // Pas complet en multiprécision : (u, v) <- (v, u mod v)
+            q = division_euclidienne(u, v, r);
+            mpz_swap(u.get_mpz_t(), v.get_mpz_t());
+            mpz_swap(v.get_mpz_t(), r.get_mpz_t());
+            if (coeffs) {
+                // (xu, xv) <- (xv, xu - q*xv), idem pour y
+                mpz_submul(xu.get_mpz_t(), q.get_mpz_t(), xv.get_mpz_t());
+                mpz_swap(xu.get_mpz_t(), xv.get_mpz_t());
+                mpz_submul(yu.get_mpz_t(), q.get_mpz_t(), yv.get_mpz_t());
+                mpz_swap(yu.get_mpz_t(), yv.get_mpz_t());
+            }
+        } else {
+            apply(u, v, t, a, b, c, d);
+            if (coeffs) {
+                apply(xu, xv, t, a, b, c, d);
+                apply(yu, yv, t, a, b, c, d);
+            }
+        }
+    }
 
-        mpz_class y_temp = y0 - q * y1;
-        y0 = y1;
-        y1 = y_temp;
+    if (coeffs) {
+        *x = swapped ? yu : xu;
+        *y = swapped ? xu : yu;
     }
+    return u;
+}
+
+// Algorithme d'Euclide étendu : retourne le pgcd de A et B ainsi que les coefficients de Bezout x et y tels que  A*x + B*y = pgcd(A, B).
+std::tuple<mpz_class, mpz_class, mpz_class> extended_gcd(const mpz_class& A, const mpz_class& B) {
+    // Le pgcd ne dépend pas des signes : on travaille sur |A|, |B|
+    mpz_class x, y;
+    mpz_class g = lehmer(abs(A), abs(B), &x, &y);
+    if (A < 0) x = -x;
+    if (B < 0) y = -y;
 
-    return {A, x0, y0}; // pgcd, x, y
+    return {g, x, y}; // pgcd, x, y
+}
+
+// PGCD seul : mêmes pas de Lehmer, sans suivre les coefficients de Bezout
+mpz_class lehmer_gcd(const mpz_class& A, const mpz_class& B) {
+    return lehmer(abs(A), abs(B), nullptr, nullptr);
 }
 
 // Inverse modulaire en utilisant l'algorithme d'Euclide étendu
@@ -41,3 +147,35 @@ mpz_class invmod(const mpz_class& A, const mpz_class& n) {
     }
     return modulo(x, n); // on normalise avec mod pour avoir un positif
 }
+
+// Astuce de Montgomery :
+//   c[i] = A[0] * ... * A[i] mod n,  u = c[k-1]^(-1)
+//   puis en remontant : inv[i] = u * c[i-1],  u = u * A[i]
+long invmod_batch(vector<mpz_class>& inv, const vector<mpz_class>& A, const mpz_class& n) {
+    inv.clear();
+    size_t k = A.size();
+    if (k == 0) return -1;
+
+    BarrettContext ctx(n);
+    vector<mpz_class> c(k);
+    c[0] = ctx.reduce(A[0]);
+    for (size_t i = 1; i < k; ++i) c[i] = mulmod(c[i - 1], A[i], ctx);
+
+    auto [g, x, y] = extended_gcd(c[k - 1], n);
+    if (g != 1) {
+        // Le produit n'est pas inversible : on cherche le coupable
+        for (size_t i = 0; i < k; ++i) {
+            if (op_pgcd(ctx.reduce(A[i]), n) != 1) return (long)i;
+        }
+        return 0;   // inatteignable : un produit d'inversibles est inversible
+    }
+
+    inv.resize(k);
+    mpz_class u = modulo(x, ctx);
+    for (size_t i = k - 1; i > 0; --i) {
+        inv[i] = mulmod(u, c[i - 1], ctx);
+        u = mulmod(u, A[i], ctx);
+    }
+    inv[0] = u;
+    return -1;
+}
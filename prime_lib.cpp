@@ -1,34 +1,230 @@
 #include<iostream>
 #include<gmpxx.h>
 #include<array>
+#include<mutex>
+#include<thread>
+#include<random>
+#include<vector>
+#include<cmath>
+#include "lib/arena.h"
 #include "lib/base.h"
 #include "lib/op_mod.h"
+#include "lib/barrett.h"
+#include "lib/prime_lib.h"
+#include "lib/instrument.h"
 
 using namespace std;
 
 
-// forward declaration
-bool primTest(const mpz_class& n);
-
-constexpr array<unsigned int, 22> SmallPrimes = {
-    7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u, 41u, 43u,
-    47u, 53u, 59u, 61u, 67u, 71u, 73u, 79u, 83u, 89u, 97u
-};
+// Petits premiers impairs < 2^16 pour le crible (Ératosthène, calculé une fois)
+static const vector<unsigned int>& sievePrimes() {
+    static const vector<unsigned int> primes = [] {
+        const unsigned int limit = 1u << 16;
+        vector<bool> composite(limit, false);
+        vector<unsigned int> out;
+        for (unsigned int i = 3; i < limit; i += 2) {
+            if (composite[i]) continue;
+            out.push_back(i);
+            for (unsigned long j = (unsigned long)i * i; j < limit; j += 2 * i) composite[j] = true;
+        }
+        return out;
+    }();
+    return primes;
+}
 
 mpz_class genAlea(gmp_randclass& rng, unsigned long bits) {
+    return genAlea(rng, bits, nullptr);
+}
+
+// Crible incrémental : un seul tirage aléatoire "start", puis une fenêtre
+// de candidats start, start+2, ..., start+2(W-1). Les restes de start
+// modulo chaque petit premier sont calculés une fois ; d'une fenêtre à
+// la suivante ils ne sont mis à jour que par addition. Seuls les
+// survivants du crible passent Miller-Rabin.
+mpz_class genAlea(gmp_randclass& rng, unsigned long bits, const std::atomic<bool>* stop,
+                  const PrimalityConfig& cfg) {
     mpz_class alea;
+
+    // Trop petit pour le crible (le candidat pourrait être l'un des premiers du crible)
+    if (bits < 32) {
+        while (true) {
+            if (stop && stop->load(memory_order_relaxed)) return 0;
+            alea = rng.get_z_bits(bits);
+            mpz_setbit(alea.get_mpz_t(), bits - 1);  // force MSB
+            mpz_setbit(alea.get_mpz_t(), 0);          // force odd
+
+            if (primTest(alea, cfg, rng)) {
+                return alea;
+            }
+        }
+    }
+
+    const vector<unsigned int>& primes = sievePrimes();
+    const unsigned int window = 4096;   // candidats impairs par fenêtre
+
+    vector<unsigned int> res(primes.size()), step(primes.size());
+    vector<unsigned char> composite(window);
+    for (size_t i = 0; i < primes.size(); ++i) step[i] = (2 * window) % primes[i];
+
     while (true) {
         alea = rng.get_z_bits(bits);
         mpz_setbit(alea.get_mpz_t(), bits - 1);  // force MSB
         mpz_setbit(alea.get_mpz_t(), 0);          // force odd
 
-        if (primTest(alea)) {
-            return alea;
+        for (size_t i = 0; i < primes.size(); ++i) {
+            res[i] = mpz_fdiv_ui(alea.get_mpz_t(), primes[i]);
         }
+
+        // Fenêtres successives tant que les candidats gardent la taille demandée
+        while (mpz_sizeinbase(alea.get_mpz_t(), 2) == bits) {
+            fill(composite.begin(), composite.end(), 0);
+            for (size_t i = 0; i < primes.size(); ++i) {
+                // start + 2j = 0 mod p  <=>  2j = p - r mod p
+                unsigned int p = primes[i], r = res[i];
+                unsigned int j = ((p - r) % 2 == 0) ? (p - r) / 2 : (2 * p - r) / 2;
+                if (j >= p) j -= p;
+                for (; j < window; j += p) composite[j] = 1;
+            }
+
+            for (unsigned int j = 0; j < window; ++j) {
+                if (composite[j]) {
+                    RSA_COUNT(sieve_rejects);
+                    continue;
+                }
+                if (stop && stop->load(memory_order_relaxed)) return 0;
+
+                mpz_class cand = alea + 2 * j;
+                if (mpz_sizeinbase(cand.get_mpz_t(), 2) != bits) break;
+                if (primTest(cand, cfg, rng)) return cand;
+            }
+
+            alea += 2 * window;
+            for (size_t i = 0; i < primes.size(); ++i) {
+                res[i] += step[i];
+                if (res[i] >= primes[i]) res[i] -= primes[i];
+            }
+        }
+    }
+}
+
+// Deux premiers distincts de 'bits' bits, cherchés en parallèle.
+// Chaque thread a son propre générateur (gmp_randclass n'est pas partagé),
+// amorcé par 256 bits tirés de rng ; dès que deux premiers sont trouvés,
+// les recherches encore en cours sont annulées.
+void genAleaPair(gmp_randclass& rng, unsigned long bits, mpz_class& p, mpz_class& q,
+                 const PrimalityConfig& cfg) {
+    unsigned int nthreads = max(2u, thread::hardware_concurrency());
+
+    vector<mpz_class> seeds(nthreads);
+    for (auto& s : seeds) s = rng.get_z_bits(256);
+
+    mutex m;
+    vector<mpz_class> found;
+    atomic<bool> stop(false);
+
+    vector<thread> workers;
+    for (unsigned int t = 0; t < nthreads; ++t) {
+        workers.emplace_back([&, t] {
+            gmp_randclass local(gmp_randinit_default);
+            local.seed(seeds[t]);
+            while (!stop.load(memory_order_relaxed)) {
+                mpz_class x = genAlea(local, bits, &stop, cfg);
+                if (x == 0) return;
+                lock_guard<mutex> lk(m);
+                if (found.size() < 2 && (found.empty() || found[0] != x)) found.push_back(x);
+                if (found.size() == 2) stop.store(true, memory_order_relaxed);
+            }
+        });
     }
+    for (auto& w : workers) w.join();
+
+    p = found[0];
+    q = found[1];
+}
+
+
+// ============================================================
+// Nombre de tours
+// ============================================================
+
+unsigned fips_error_bits(unsigned long bits) {
+    if (2 * bits < 2048) return 100;
+    if (2 * bits < 3072) return 112;
+    return 128;
+}
+
+// log2 de la meilleure des bornes de Damgård, Landrock et Pomerance
+// (1993) valables pour (k, t) ; ce sont elles qui donnent les tables
+// de FIPS 186-5 et de Menezes et al. (HAC, table 4.4)
+static double mr_error_log2(double k, double t) {
+    double best = 0;
+    if (t == 1) best = min(best, 2 * log2(k) + 2 * (2 - sqrt(k)));
+    if ((t == 2 && k >= 88) || (t >= 3 && t <= k / 9)) {
+        best = min(best, 1.5 * log2(k) + t - 0.5 * log2(t) + 2 * (2 - sqrt(t * k)));
+    }
+    if (t >= k / 9 && t <= k / 4) {
+        double p = 7.0 / 20 * k * exp2(-5 * t)
+                 + 1.0 / 7 * pow(k, 3.75) * exp2(-k / 2 - 2 * t)
+                 + 12 * k * exp2(-k / 4 - 3 * t);
+        best = min(best, log2(p));
+    }
+    if (t >= k / 4) best = min(best, log2(1.0 / 7) + 3.75 * log2(k) - k / 2 - 2 * t);
+    return best;
 }
 
-// primTest() 
+unsigned mr_rounds(unsigned long bits, unsigned error_bits) {
+    if (bits < 21) throw invalid_argument("mr_rounds : au moins 21 bits");
+    unsigned t = 1;
+    while (mr_error_log2((double)bits, t) > -(double)error_bits) ++t;
+    return t;
+}
+
+// ============================================================
+// Miller-Rabin
+// ============================================================
+
+static inline void add_mod(mpz_class& x, const mpz_class& y, const mpz_class& n) {
+    mpz_add(x.get_mpz_t(), x.get_mpz_t(), y.get_mpz_t());
+    if (x >= n) mpz_sub(x.get_mpz_t(), x.get_mpz_t(), n.get_mpz_t());
+}
+
+// Fin du tour, x = a^d déjà dans le domaine : les carrés successifs y
+// restent, 1 et -1 y valent R mod n et n - (R mod n)
+static bool mr_squarings(const MontgomeryContext& mc, mpz_class& x, unsigned long s) {
+    ScratchArena::Frame frame;
+    mpz_class& minus_one = frame.num();
+    minus_one = mc.modulus() - mc.one();
+    if (x == mc.one() || x == minus_one) return true;
+    for (unsigned long r = 1; r < s; ++r) {
+        mc.mul(x, x, x);
+        if (x == minus_one) return true;
+        if (x == mc.one()) return false;  // racine carrée de 1 autre que +-1
+    }
+    return false;
+}
+
+bool miller_rabin(const MontgomeryContext& mc, const ExpPlan& d, unsigned long s,
+                  const mpz_class& a) {
+    ScratchArena::Frame frame(mc.bits());
+    mpz_class& x = frame.num();
+    mc.exp_mont(x, a, d);
+    return mr_squarings(mc, x, s);
+}
+
+// Base 2 : binaire de gauche à droite où la multiplication par la base
+// est un doublement (addition modulaire), sans table de fenêtres
+static bool miller_rabin_2(const MontgomeryContext& mc, const mpz_class& d, unsigned long s) {
+    const mpz_class& n = mc.modulus();
+    ScratchArena::Frame frame(mc.bits());
+    mpz_class& x = frame.num();
+    x = mc.one();
+    add_mod(x, x, n);
+    for (long i = (long)mpz_sizeinbase(d.get_mpz_t(), 2) - 2; i >= 0; --i) {
+        mc.mul(x, x, x);
+        if (mpz_tstbit(d.get_mpz_t(), i)) add_mod(x, x, n);
+    }
+    return mr_squarings(mc, x, s);
+}
 
 bool miller_rabin(
     const mpz_class& n,
@@ -36,19 +232,139 @@ bool miller_rabin(
     const mpz_class& d,
     unsigned long s,
     const mpz_class& a) {
-    mpz_class x;
+    (void)n_1;
+    MontgomeryContext mc(n);
+    return miller_rabin(mc, window_plan(d), s, a);
+}
+
+// Variante de Barrett : les s-1 élévations au carré se font en place
+// dans un contexte construit une seule fois pour n (partagé entre les bases)
+bool miller_rabin(
+    const mpz_class& n,
+    const mpz_class& n_1,
+    const mpz_class& d,
+    unsigned long s,
+    const mpz_class& a,
+    const BarrettContext& ctx) {
+    ScratchArena::Frame frame;
+    mpz_class& x = frame.num();
 
     x = mod_exp_window(a, d, n);
     if (x == 1 || x == n_1) return true;
     for (unsigned long r = 1; r < s; ++r) {
-        x= mulmod(x, x, n); //alt ?
-        // x=modulo( x, n);
+        ctx.mul(x, x, x);
         if (x == n_1) return true;
     }
     return false;
 }
 
+// ============================================================
+// Lucas fort (P = 1, Q = (1 - D) / 4, méthode A de Selfridge)
+// ============================================================
+
+// Symbole de Jacobi (a/n), n impair positif, a impair et petit
+static int jacobi(long a, const mpz_class& n) {
+    int j = 1;
+    unsigned long m = (unsigned long)labs(a);
+    unsigned long n4 = mpz_fdiv_ui(n.get_mpz_t(), 4);
+    if (a < 0 && n4 == 3) j = -j;           // (-1/n)
+    if (m % 4 == 3 && n4 == 3) j = -j;      // réciprocité : (m/n) -> (n/m)
+    unsigned long x = mpz_fdiv_ui(n.get_mpz_t(), m), y = m;
+    while (x != 0) {
+        while (x % 2 == 0) {
+            x /= 2;
+            if (y % 8 == 3 || y % 8 == 5) j = -j;
+        }
+        swap(x, y);
+        if (x % 4 == 3 && y % 4 == 3) j = -j;
+        x %= y;
+    }
+    return y == 1 ? j : 0;
+}
+
+static inline void sub_mod(mpz_class& x, const mpz_class& y, const mpz_class& n) {
+    mpz_sub(x.get_mpz_t(), x.get_mpz_t(), y.get_mpz_t());
+    if (sgn(x) < 0) mpz_add(x.get_mpz_t(), x.get_mpz_t(), n.get_mpz_t());
+}
+
+// x / 2 mod n (n impair) ; linéaire, donc valable dans le domaine
+static inline void half_mod(mpz_class& x, const mpz_class& n) {
+    if (mpz_odd_p(x.get_mpz_t())) mpz_add(x.get_mpz_t(), x.get_mpz_t(), n.get_mpz_t());
+    mpz_fdiv_q_2exp(x.get_mpz_t(), x.get_mpz_t(), 1);
+}
+
+// n + 1 = d * 2^s ; n premier probable si U_d = 0 ou V_(d 2^r) = 0 pour
+// un r < s. U, V et Q^k restent dans le domaine de Montgomery de mc.
+bool strong_lucas(const MontgomeryContext& mc) {
+    const mpz_class& n = mc.modulus();
+
+    // D = 5, -7, 9, -11, ... jusqu'à (D/n) = -1 ; un carré n'en a aucun,
+    // on le vérifie après quelques essais
+    long D = 5;
+    for (unsigned i = 0;; ++i) {
+        int j = jacobi(D, n);
+        if (j == -1) break;
+        if (j == 0) return mpz_cmpabs_ui(n.get_mpz_t(), (unsigned long)labs(D)) == 0;
+        if (i == 8 && mpz_perfect_square_p(n.get_mpz_t())) return false;
+        D = D > 0 ? -(D + 2) : -D + 2;
+    }
+    long Q = (1 - D) / 4;
+
+    ScratchArena::Frame frame(mc.bits());
+    mpz_class& d = frame.num();
+    mpz_class& U = frame.num();
+    mpz_class& V = frame.num();
+    mpz_class& Qk = frame.num();
+    mpz_class& Dm = frame.num();
+    mpz_class& Qm = frame.num();
+    mpz_class& t = frame.num();
+
+    d = n + 1;
+    unsigned long s = mpz_scan1(d.get_mpz_t(), 0);
+    mpz_fdiv_q_2exp(d.get_mpz_t(), d.get_mpz_t(), s);
+
+    Dm = D;
+    mc.enter(Dm, Dm);
+    Qm = Q;
+    mc.enter(Qm, Qm);
+
+    // k = 1 : U_1 = 1, V_1 = P = 1, Q^1 ; puis les bits de d
+    U = mc.one();
+    V = mc.one();
+    Qk = Qm;
+    for (long i = (long)mpz_sizeinbase(d.get_mpz_t(), 2) - 2; i >= 0; --i) {
+        // k -> 2k : U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+        mc.mul(U, U, V);
+        mc.mul(V, V, V);
+        sub_mod(V, Qk, n);
+        sub_mod(V, Qk, n);
+        mc.mul(Qk, Qk, Qk);
+        if (mpz_tstbit(d.get_mpz_t(), i)) {
+            // k -> k+1 : U = (U + V) / 2, V = (D U + V) / 2
+            mc.mul(t, Dm, U);
+            add_mod(U, V, n);
+            half_mod(U, n);
+            add_mod(t, V, n);
+            half_mod(t, n);
+            swap(V, t);
+            mc.mul(Qk, Qk, Qm);
+        }
+    }
+
+    if (sgn(U) == 0 || sgn(V) == 0) return true;
+    for (unsigned long r = 1; r < s; ++r) {
+        mc.mul(V, V, V);
+        sub_mod(V, Qk, n);
+        sub_mod(V, Qk, n);
+        if (sgn(V) == 0) return true;
+        mc.mul(Qk, Qk, Qk);
+    }
+    return false;
+}
 
+// ============================================================
+// primTest
+// ============================================================
 
 bool trialDiv(const mpz_class& n){
     if(n < 2) return false;
@@ -63,20 +379,87 @@ bool trialDiv(const mpz_class& n){
     return true;
 }
 
-bool  primTest(const mpz_class& n){
-    if(!trialDiv(n)) return false;
-    mpz_class n_1 = n - 1;
-    mpz_class d,b_value;
-    unsigned long s;
-    static const unsigned long reduced_bases[] = {2ul, 3ul, 5ul, 7ul, 11ul};
+// Générateur du thread pour les bases aléatoires, amorcé par 256 bits du
+// système : un n choisi par un tiers ne doit pas pouvoir viser les bases
+static gmp_randclass& local_rng() {
+    thread_local gmp_randclass rng(gmp_randinit_default);
+    thread_local bool seeded = false;
+    if (!seeded) {
+        random_device rd;
+        mpz_class s = 0;
+        for (int i = 0; i < 8; ++i) s = (s << 32) | rd();
+        rng.seed(s);
+        seeded = true;
+    }
+    return rng;
+}
+
+bool primTest(const mpz_class& n, const PrimalityConfig& cfg) {
+    return primTest(n, cfg, local_rng());
+}
+
+bool primTest(const mpz_class& n, const PrimalityConfig& cfg, gmp_randclass& rng) {
+    RSA_COUNT(prime_candidates);
+    if(!trialDiv(n)) {
+        RSA_COUNT(trialdiv_rejects);
+        return false;
+    }
+    // Sans facteur <= 97 et n < 101^2 : premier
+    if (n < 10201) return true;
 
-    s = mpz_scan1(n_1.get_mpz_t(), 0);  //why 
-    mpz_fdiv_q_2exp(d.get_mpz_t(), n_1.get_mpz_t(), s); //why 
-    for (unsigned long base : reduced_bases) {
-        if (mpz_cmp_ui(n.get_mpz_t(), base) <= 0) continue;
-        mpz_set_ui(b_value.get_mpz_t(), base);  //why
-        if (!miller_rabin(n, n_1, d, s, b_value)) return false;
-    }    
+    unsigned long bits = mpz_sizeinbase(n.get_mpz_t(), 2);
+    ScratchArena::Frame frame(bits);
+    mpz_class& n_1 = frame.num();
+    mpz_class& d = frame.num();
+    mpz_class& a = frame.num();
 
+    n_1 = n - 1;
+    unsigned long s = mpz_scan1(n_1.get_mpz_t(), 0);
+    mpz_fdiv_q_2exp(d.get_mpz_t(), n_1.get_mpz_t(), s);
+    MontgomeryContext mc(n);
+
+    RSA_COUNT(mr_rounds);
+    if (!miller_rabin_2(mc, d, s)) {
+        RSA_COUNT(mr_rejects);
+        return false;
+    }
+
+    // Découpe de d pour les autres bases, faite une fois
+    ExpPlan plan = window_plan(d);
+    auto round = [&] {
+        RSA_COUNT(mr_rounds);
+        if (miller_rabin(mc, plan, s, a)) return true;
+        RSA_COUNT(mr_rejects);
+        return false;
+    };
+
+    // n < 2^64 : les douze premières bases suffisent (n < 3,1 * 10^23)
+    if (bits <= 64) {
+        static const unsigned long det_bases[] = {3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+        for (unsigned long base : det_bases) {
+            a = base;
+            if (!round()) return false;
+        }
+        return true;
+    }
+
+    unsigned rounds = cfg.rounds;
+    if (cfg.mode == PrimalityMode::BailliePSW) {
+        RSA_COUNT(lucas_tests);
+        if (!strong_lucas(mc)) {
+            RSA_COUNT(lucas_rejects);
+            return false;
+        }
+    } else if (rounds == 0) {
+        rounds = mr_rounds(bits, cfg.error_bits ? cfg.error_bits : fips_error_bits(bits));
+    }
+
+    // Bases aléatoires dans [2, n - 2]
+    mpz_class& range = frame.num();
+    range = n - 3;
+    for (unsigned i = 0; i < rounds; ++i) {
+        a = rng.get_z_range(range) + 2;
+        if (!round()) return false;
+    }
     return true;
 }
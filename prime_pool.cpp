@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gmpxx.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "lib/prime_lib.h"
+#include "lib/prime_pool.h"
+
+using namespace std;
+
+namespace {
+
+// ============================================================
+// File bornée MPMC de Vyukov
+//   case i : seq = i      libre pour l'écriture de rang i
+//            seq = i + 1  pleine, lisible au rang i
+//   la lecture de rang i la rend libre pour le rang i + capacité.
+// Producteurs et consommateurs ne se croisent que sur enq_ / deq_
+// (chacun sur sa ligne de cache) et sur le numéro de la case visée.
+// ============================================================
+class PrimeQueue {
+public:
+    explicit PrimeQueue(size_t capacity) : mask_(capacity - 1), cells_(new Cell[capacity]) {
+        for (size_t i = 0; i < capacity; ++i) cells_[i].seq.store(i, memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // x passe dans la file (échangé, x reçoit l'ancienne valeur de la
+    // case) ; false si elle est pleine
+    bool push(mpz_class& x) {
+        size_t pos = enq_.load(memory_order_relaxed);
+        Cell* c;
+        while (true) {
+            c = &cells_[pos & mask_];
+            size_t seq = c->seq.load(memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0) {
+                if (enq_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = enq_.load(memory_order_relaxed);
+            }
+        }
+        mpz_swap(c->value.get_mpz_t(), x.get_mpz_t());
+        c->seq.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(mpz_class& x) {
+        size_t pos = deq_.load(memory_order_relaxed);
+        Cell* c;
+        while (true) {
+            c = &cells_[pos & mask_];
+            size_t seq = c->seq.load(memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (dif == 0) {
+                if (deq_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = deq_.load(memory_order_relaxed);
+            }
+        }
+        mpz_swap(x.get_mpz_t(), c->value.get_mpz_t());
+        c->seq.store(pos + mask_ + 1, memory_order_release);
+        return true;
+    }
+
+    // Profondeur approchée (lectures relâchées des deux compteurs)
+    size_t depth() const {
+        size_t e = enq_.load(memory_order_relaxed);
+        size_t d = deq_.load(memory_order_relaxed);
+        return e > d ? min(e - d, capacity()) : 0;
+    }
+
+private:
+    struct Cell {
+        atomic<size_t> seq;
+        mpz_class value;
+    };
+
+    const size_t mask_;
+    unique_ptr<Cell[]> cells_;
+    alignas(64) atomic<size_t> enq_{0};
+    alignas(64) atomic<size_t> deq_{0};
+};
+
+struct Slot {
+    Slot(unsigned long b, size_t capacity) : bits(b), queue(capacity) {}
+
+    unsigned long bits;
+    PrimeQueue queue;
+    atomic<size_t> pending{0};       // en cours de génération
+    atomic<uint64_t> generated{0};
+    atomic<uint64_t> served{0};
+    atomic<uint64_t> misses{0};
+    atomic<uint64_t> gen_ns{0};
+};
+
+}  // namespace
+
+struct PrimePool::Impl {
+    explicit Impl(const PrimalityConfig& c) : cfg(c), start(chrono::steady_clock::now()) {}
+
+    PrimalityConfig cfg;
+    vector<unique_ptr<Slot>> slots;
+    vector<thread> workers;
+    chrono::steady_clock::time_point start;
+
+    mutex sleep_m;
+    condition_variable cv;
+    atomic<unsigned> sleepers{0};
+    atomic<bool> stop{false};
+
+    Slot* find(unsigned long bits) {
+        for (auto& s : slots) {
+            if (s->bits == bits) return s.get();
+        }
+        return nullptr;
+    }
+
+    // File la moins remplie, premiers en cours compris ; nullptr si
+    // toutes seront pleines
+    Slot* neediest() {
+        Slot* best = nullptr;
+        double fill = 1.0;
+        for (auto& s : slots) {
+            size_t have = s->queue.depth() + s->pending.load(memory_order_relaxed);
+            double f = (double)have / s->queue.capacity();
+            if (f < fill) {
+                fill = f;
+                best = s.get();
+            }
+        }
+        return best;
+    }
+
+    // Réveil des threads endormis après un retrait. Le verrou n'est pris
+    // que si l'un d'eux dort : il vérifie neediest() sous ce verrou avant
+    // d'attendre, le réveil ne peut donc pas se perdre.
+    void wake() {
+        atomic_thread_fence(memory_order_seq_cst);   // retrait visible avant la lecture
+        if (sleepers.load(memory_order_relaxed) == 0) return;
+        lock_guard<mutex> lk(sleep_m);
+        cv.notify_one();
+    }
+
+    void run(const mpz_class& seed) {
+#ifdef __linux__
+        // Priorité la plus basse : la recharge ne prend que le temps
+        // processeur laissé libre par les threads de requêtes
+        sched_param sp{};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &sp);
+#endif
+        gmp_randclass rng(gmp_randinit_default);
+        rng.seed(seed);
+
+        while (!stop.load(memory_order_relaxed)) {
+            Slot* s = neediest();
+            if (!s) {
+                unique_lock<mutex> lk(sleep_m);
+                sleepers.fetch_add(1);
+                atomic_thread_fence(memory_order_seq_cst);
+                cv.wait(lk, [this] { return stop.load() || neediest() != nullptr; });
+                sleepers.fetch_sub(1);
+                continue;
+            }
+
+            s->pending.fetch_add(1, memory_order_relaxed);
+            auto t0 = chrono::steady_clock::now();
+            mpz_class p = genAlea(rng, s->bits, &stop, cfg);
+            auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0);
+            s->pending.fetch_sub(1, memory_order_relaxed);
+            if (p == 0) return;   // arrêt demandé
+
+            s->gen_ns.fetch_add((uint64_t)ns.count(), memory_order_relaxed);
+            s->generated.fetch_add(1, memory_order_relaxed);
+            s->queue.push(p);     // pleine entre-temps : premier perdu (rare)
+        }
+    }
+};
+
+PrimePool::PrimePool(const vector<unsigned long>& sizes, size_t capacity, unsigned threads,
+                     unsigned long seed, const PrimalityConfig& cfg)
+    : impl_(new Impl(cfg)) {
+    if (sizes.empty()) throw invalid_argument("PrimePool : aucune taille");
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+
+    size_t cap = 2;
+    while (cap < capacity) cap *= 2;
+    for (unsigned long bits : sizes) {
+        if (bits < 2) throw invalid_argument("PrimePool : taille trop petite");
+        if (!impl_->find(bits)) impl_->slots.emplace_back(new Slot(bits, cap));
+    }
+
+    // seed = 0 : 256 bits de random_device par thread (les premiers servis
+    // sont des secrets, l'horloge ne suffit pas)
+    random_device rd;
+    for (unsigned i = 0; i < threads; ++i) {
+        mpz_class s = seed;
+        if (seed == 0) {
+            for (int j = 0; j < 8; ++j) s = (s << 32) | rd();
+        } else {
+            s += i;
+        }
+        impl_->workers.emplace_back([this, s] { impl_->run(s); });
+    }
+}
+
+PrimePool::~PrimePool() {
+    {
+        lock_guard<mutex> lk(impl_->sleep_m);
+        impl_->stop.store(true);
+    }
+    impl_->cv.notify_all();
+    for (auto& t : impl_->workers) t.join();
+}
+
+bool PrimePool::try_take(unsigned long bits, mpz_class& p) {
+    Slot* s = impl_->find(bits);
+    if (!s) return false;
+    if (!s->queue.pop(p)) {
+        s->misses.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    s->served.fetch_add(1, memory_order_relaxed);
+    impl_->wake();
+    return true;
+}
+
+mpz_class PrimePool::take(unsigned long bits, gmp_randclass& rng) {
+    mpz_class p;
+    if (try_take(bits, p)) return p;
+    return genAlea(rng, bits, nullptr, impl_->cfg);
+}
+
+vector<PrimePoolStats> PrimePool::stats() const {
+    double uptime = chrono::duration<double>(chrono::steady_clock::now() - impl_->start).count();
+    vector<PrimePoolStats> out;
+    for (const auto& s : impl_->slots) {
+        PrimePoolStats st;
+        st.bits = s->bits;
+        st.depth = s->queue.depth();
+        st.capacity = s->queue.capacity();
+        st.generated = s->generated.load(memory_order_relaxed);
+        st.served = s->served.load(memory_order_relaxed);
+        st.misses = s->misses.load(memory_order_relaxed);
+        st.refill_rate = uptime > 0 ? st.generated / uptime : 0;
+        st.mean_gen_ms = st.generated ? s->gen_ns.load(memory_order_relaxed) / 1e6 / st.generated : 0;
+        out.push_back(st);
+    }
+    return out;
+}
@@ -3,16 +3,14 @@
 #include "lib/base.h"
 #include "lib/prime_lib.h"
 #include "lib/op_mod.h"
+#include "lib/rsa.h"
 
 
 using namespace std;
 
 
 void keyGen(unsigned long bits, gmp_randclass& rng, mpz_class& n, mpz_class& e, mpz_class& d, mpz_class& p, mpz_class& q, mpz_class& phi) {
-    p = genAlea(rng, bits / 2);
-    do {
-        q = genAlea(rng, bits / 2);
-    } while (q == p);
+    genAleaPair(rng, bits / 2, p, q);
     n = p * q;
     phi = (p - 1) * (q - 1);
 
@@ -30,7 +28,7 @@ void keyGen(unsigned long bits, gmp_randclass& rng, mpz_class& n, mpz_class& e,
 
 void enc(mpz_class& c, string m, const mpz_class& e, const mpz_class& n) {
     stringToNum(c, m);
-    c = ExpoMod(c, e, n);
+    c = (e == 65537) ? mod_exp_65537(c, n) : ExpoMod(c, e, n);
 }
 
 void dec(string& m, const mpz_class& c, const mpz_class& d, const mpz_class& n) {
@@ -48,8 +46,18 @@ void sing(mpz_class& signature, const string& message, const mpz_class& d, const
 bool verify(const mpz_class& signature, const string& message, const mpz_class& e, const mpz_class& n) {
     mpz_class m_num;
     stringToNum(m_num, message);
-    mpz_class decrypted = mod_exp_window(signature, e, n);
+    mpz_class decrypted = (e == 65537) ? mod_exp_65537(signature, n)
+                                       : mod_exp_window(signature, e, n);
     return decrypted == m_num;
 }
 
+void enc(mpz_class& c, const string& m, const RsaPublicKey& key) {
+    stringToNum(c, m);
+    c = key.pow(c);
+}
 
+bool verify(const mpz_class& signature, const string& message, const RsaPublicKey& key) {
+    mpz_class m_num;
+    stringToNum(m_num, message);
+    return key.pow(signature) == m_num;
+}
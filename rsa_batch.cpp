@@ -0,0 +1,240 @@
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/op_mod.h"
+#include "lib/montgomery.h"
+#include "lib/crt_context.h"
+#include "lib/mont_lanes.h"
+#include "lib/rsa_batch.h"
+
+using namespace std;
+
+namespace {
+
+// ============================================================
+// Arbre du batch RSA de Fiat
+//   feuille i : E = e[i], v = c[i]
+//   noeud     : E = E_L * E_R, v = v_L^E_R * v_R^E_L
+// Les produits de deux puissances sont des multi-exponentiations
+// (une seule chaîne de carrés, MontgomeryContext::multi_exp).
+// À la racine, r = v^(1/E) ; en redescendant, r se sépare en
+//   r_L = v_L^(1/E_L) et r_R = v_R^(1/E_R).
+// ============================================================
+struct FiatNode {
+    mpz_class E, v;
+    int left = -1, right = -1;
+    size_t leaf = 0;
+};
+
+class FiatTree {
+public:
+    FiatTree(const vector<mpz_class>& c, const vector<mpz_class>& e, const mpz_class& n)
+        : ctx_(n), n_(n) {
+        root_ = build(c, e, 0, c.size());
+    }
+
+    const FiatNode& root() const { return nodes_[root_]; }
+
+    void descend(const mpz_class& r, vector<mpz_class>& out) const { split(root_, r, out); }
+
+private:
+    MontgomeryContext ctx_;
+    mpz_class n_;
+    vector<FiatNode> nodes_;
+    int root_;
+
+    mpz_class mul(const mpz_class& a, const mpz_class& b) const {
+        return ctx_.mul(ctx_.to_mont(a), b);
+    }
+
+    int build(const vector<mpz_class>& c, const vector<mpz_class>& e, size_t lo, size_t hi) {
+        FiatNode node;
+        if (hi - lo == 1) {
+            node.E = e[lo];
+            node.v = modulo(c[lo], n_);
+            node.leaf = lo;
+        } else {
+            size_t mid = lo + (hi - lo) / 2;
+            node.left = build(c, e, lo, mid);
+            node.right = build(c, e, mid, hi);
+            const FiatNode& L = nodes_[node.left];
+            const FiatNode& R = nodes_[node.right];
+            node.E = L.E * R.E;
+            node.v = ctx_.multi_exp({L.v, R.v}, {R.E, L.E});
+        }
+        nodes_.push_back(node);
+        return (int)nodes_.size() - 1;
+    }
+
+    void split(int idx, const mpz_class& r, vector<mpz_class>& out) const {
+        const FiatNode& node = nodes_[idx];
+        if (node.left < 0) {
+            out[node.leaf] = r;
+            return;
+        }
+        const FiatNode& L = nodes_[node.left];
+        const FiatNode& R = nodes_[node.right];
+
+        // X = 0 mod E_R et X = 1 mod E_L, d'où
+        //   r^X = v_L^((X-1)/E_L) * v_L^(1/E_L) * v_R^(X/E_R)
+        mpz_class X = R.E * invmod(R.E, L.E);
+        mpz_class den = ctx_.multi_exp({L.v, R.v}, {quotient(X - 1, L.E), quotient(X, R.E)});
+
+        mpz_class rL = mul(ctx_.exp(r, X), invmod(den, n_));
+        mpz_class rR = mul(r, invmod(rL, n_));
+
+        split(node.left, rL, out);
+        split(node.right, rR, out);
+    }
+};
+
+}  // namespace
+
+// ============================================================
+// Dec CRT par lot — mêmes formules que dec_crt, précalculs partagés
+// ============================================================
+void dec_crt_batch(vector<string>& m, const vector<mpz_class>& c,
+                   const mpz_class& p, const mpz_class& q,
+                   const mpz_class& dp, const mpz_class& dq,
+                   const mpz_class& qinv) {
+    CrtContext crt(p, q, qinv);
+    m.resize(c.size());
+    for (size_t i = 0; i < c.size(); ++i) {
+        numToString(m[i], crt.pow(c[i], dp, dq));
+    }
+}
+
+// ============================================================
+// Sign CRT par lot
+// ============================================================
+void sing_crt_batch(vector<mpz_class>& signatures, const vector<string>& messages,
+                    const mpz_class& p, const mpz_class& q,
+                    const mpz_class& dp, const mpz_class& dq,
+                    const mpz_class& qinv) {
+    CrtContext crt(p, q, qinv);
+    signatures.resize(messages.size());
+    mpz_class m_num;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        stringToNum(m_num, messages[i]);
+        signatures[i] = crt.pow(m_num, dp, dq);
+    }
+}
+
+void dec_crt_batch(vector<string>& m, const vector<mpz_class>& c,
+                   const RsaPrivateKey& key) {
+    m.resize(c.size());
+    for (size_t i = 0; i < c.size(); ++i) {
+        numToString(m[i], key.pow(c[i]));
+    }
+}
+
+void sing_crt_batch(vector<mpz_class>& signatures, const vector<string>& messages,
+                    const RsaPrivateKey& key) {
+    signatures.resize(messages.size());
+    mpz_class m_num;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        stringToNum(m_num, messages[i]);
+        signatures[i] = key.pow(m_num);
+    }
+}
+
+// ============================================================
+// Batch RSA de Fiat
+// ============================================================
+void dec_batch_fiat(vector<string>& m, const vector<mpz_class>& c,
+                    const vector<mpz_class>& e,
+                    const mpz_class& p, const mpz_class& q) {
+    if (c.size() != e.size()) {
+        throw invalid_argument("dec_batch_fiat : autant d'exposants que de chiffrés");
+    }
+    m.assign(c.size(), string());
+    if (c.empty()) return;
+
+    mpz_class n = p * q;
+    mpz_class p_1 = p - 1, q_1 = q - 1;
+    CrtContext crt(p, q, invmod(q, p));
+
+    // Conditions de Fiat : exposants deux à deux premiers entre eux,
+    // et leur produit premier avec phi (donc chacun inversible)
+    bool fiat = true;
+    mpz_class E = 1;
+    for (size_t i = 0; i < e.size() && fiat; ++i) {
+        for (size_t j = 0; j < i && fiat; ++j) {
+            if (op_pgcd(e[i], e[j]) != 1) fiat = false;
+        }
+        E *= e[i];
+    }
+    if (fiat && op_pgcd(E, p_1 * q_1) != 1) fiat = false;
+
+    if (fiat) {
+        try {
+            FiatTree tree(c, e, n);
+            const FiatNode& root = tree.root();
+
+            // Seule exponentiation complète du lot : r = v^(1/E) par CRT
+            mpz_class r = crt.pow(root.v, invmod(root.E, p_1), invmod(root.E, q_1));
+
+            vector<mpz_class> roots(c.size());
+            tree.descend(r, roots);
+            for (size_t i = 0; i < c.size(); ++i) numToString(m[i], roots[i]);
+            return;
+        } catch (const runtime_error&) {
+            // Un chiffré non inversible modulo n : repli sur le CRT
+        }
+    }
+
+    for (size_t i = 0; i < c.size(); ++i) {
+        numToString(m[i], crt.pow(c[i], invmod(e[i], p_1), invmod(e[i], q_1)));
+    }
+}
+
+// ============================================================
+// Vérification par lot
+//   signatures regroupées par nombre de mots en base 2^52, puis par
+//   paquets de MontLanes::LANES (les modules d'un paquet peuvent être
+//   tous différents, ou tous identiques)
+// ============================================================
+void verify_batch(vector<bool>& ok, const vector<mpz_class>& sigs,
+                  const vector<string>& msgs,
+                  const vector<const RsaPublicKey*>& keys) {
+    if (sigs.size() != msgs.size() || sigs.size() != keys.size()) {
+        throw invalid_argument("verify_batch : une clé et un message par signature");
+    }
+    ok.assign(sigs.size(), false);
+
+    map<size_t, vector<size_t>> groups;   // nombre de mots -> signatures
+    for (size_t i = 0; i < sigs.size(); ++i) {
+        if (sigs[i] < 0 || sigs[i] >= keys[i]->n()) continue;
+        groups[keys[i]->lane_modulus().limbs()].push_back(i);
+    }
+
+    mpz_class m_num;
+    for (const auto& [limbs, idx] : groups) {
+        for (size_t lo = 0; lo < idx.size(); lo += MontLanes::LANES) {
+            size_t cnt = min(MontLanes::LANES, idx.size() - lo);
+            size_t bits = mpz_sizeinbase(keys[idx[lo]]->n().get_mpz_t(), 2);
+
+            vector<mpz_class> r(cnt);
+            if (MontLanes::profitable(bits, cnt)) {
+                vector<const LaneModulus*> mods(cnt);
+                vector<mpz_class> bases(cnt), exps(cnt);
+                for (size_t j = 0; j < cnt; ++j) {
+                    size_t i = idx[lo + j];
+                    mods[j] = &keys[i]->lane_modulus();
+                    bases[j] = sigs[i];
+                    exps[j] = keys[i]->e();
+                }
+                MontLanes(mods).exp(r, bases, exps);
+            } else {
+                for (size_t j = 0; j < cnt; ++j) r[j] = keys[idx[lo + j]]->pow(sigs[idx[lo + j]]);
+            }
+
+            for (size_t j = 0; j < cnt; ++j) {
+                stringToNum(m_num, msgs[idx[lo + j]]);
+                ok[idx[lo + j]] = r[j] == m_num;
+            }
+        }
+    }
+}
@@ -1,8 +1,13 @@
 #include <iostream>
+#include <future>
 #include <gmpxx.h>
+#include "lib/arena.h"
 #include "lib/base.h"
 #include "lib/prime_lib.h"
+#include "lib/prime_pool.h"
 #include "lib/op_mod.h"
+#include "lib/rsa_crt.h"
+#include "lib/mont_lanes.h"
 
 using namespace std;
 
@@ -11,15 +16,20 @@ using namespace std;
 //   dp = d mod (p-1)
 //   dq = d mod (q-1)
 //   qinv = q^(-1) mod p
+// Avec une réserve, p et q sont pris dans sa file en O(1) ; si elle est
+// vide dès p, la paire est cherchée en parallèle comme sans réserve,
+// sinon seul q est généré sur le thread appelant
 // ============================================================
 void keyGen_crt(unsigned long bits, gmp_randclass& rng,
                 mpz_class& n, mpz_class& e, mpz_class& d,
                 mpz_class& p, mpz_class& q, mpz_class& phi,
-                mpz_class& dp, mpz_class& dq, mpz_class& qinv) {
-    p = genAlea(rng, bits / 2);
-    do {
-        q = genAlea(rng, bits / 2);
-    } while (q == p);
+                mpz_class& dp, mpz_class& dq, mpz_class& qinv,
+                PrimePool* pool) {
+    if (pool && pool->try_take(bits / 2, p)) {
+        do q = pool->take(bits / 2, rng); while (q == p);
+    } else {
+        genAleaPair(rng, bits / 2, p, q);
+    }
 
     n   = p * q;
     phi = (p - 1) * (q - 1);
@@ -40,6 +50,36 @@ void keyGen_crt(unsigned long bits, gmp_randclass& rng,
     qinv = invmod(q, p);           // q^(-1) mod p
 }
 
+// ============================================================
+// Les deux moitiés CRT sont indépendantes : en mode parallèle, m1 est
+// calculé sur un second thread pendant que l'appelant calcule m2 ; sur
+// un seul coeur, les deux tournent de front sur deux voies de MontLanes
+// quand le noyau vectoriel y gagne (constantes des modules comprises)
+// ============================================================
+static void crt_halves(mpz_class& m1, mpz_class& m2, const mpz_class& x,
+                       const mpz_class& p, const mpz_class& q,
+                       const mpz_class& dp, const mpz_class& dq,
+                       bool parallel) {
+    if (!parallel && MontLanes::profitable(mpz_sizeinbase(p.get_mpz_t(), 2), 2)) {
+        LaneModulus lp(p), lq(q);
+        if (lp.limbs() == lq.limbs()) {
+            vector<mpz_class> m;
+            MontLanes({&lp, &lq}).exp(m, {modulo(x, p), modulo(x, q)}, {dp, dq});
+            m1 = m[0];
+            m2 = m[1];
+            return;
+        }
+    }
+    if (!parallel) {
+        m1 = mod_exp_window(x, dp, p);
+        m2 = mod_exp_window(x, dq, q);
+        return;
+    }
+    future<mpz_class> half_p = async(launch::async, [&] { return mod_exp_window(x, dp, p); });
+    m2 = mod_exp_window(x, dq, q);
+    m1 = half_p.get();
+}
+
 // ============================================================
 // Dec CRT — déchiffrement via le Théorème des Restes Chinois
 //   m1 = c^dp mod p
@@ -50,9 +90,9 @@ void keyGen_crt(unsigned long bits, gmp_randclass& rng,
 void dec_crt(string& m, const mpz_class& c,
              const mpz_class& p, const mpz_class& q,
              const mpz_class& dp, const mpz_class& dq,
-             const mpz_class& qinv) {
-    mpz_class m1 = mod_exp_window(c, dp, p);   // c^dp mod p
-    mpz_class m2 = mod_exp_window(c, dq, q);   // c^dq mod q
+             const mpz_class& qinv, bool parallel) {
+    mpz_class m1, m2;
+    crt_halves(m1, m2, c, p, q, dp, dq, parallel);   // c^dp mod p, c^dq mod q
 
     mpz_class h = modulo(qinv * (m1 - m2 + p), p);  // +p pour éviter négatif
     mpz_class result = m2 + h * q;
@@ -66,13 +106,38 @@ void dec_crt(string& m, const mpz_class& c,
 void sing_crt(mpz_class& signature, const string& message,
               const mpz_class& p, const mpz_class& q,
               const mpz_class& dp, const mpz_class& dq,
-              const mpz_class& qinv) {
+              const mpz_class& qinv, bool parallel) {
     mpz_class m_num;
     stringToNum(m_num, message);
 
-    mpz_class s1 = mod_exp_window(m_num, dp, p);
-    mpz_class s2 = mod_exp_window(m_num, dq, q);
+    mpz_class s1, s2;
+    crt_halves(s1, s2, m_num, p, q, dp, dq, parallel);
 
     mpz_class h = modulo(qinv * (s1 - s2 + p), p);
     signature = s2 + h * q;
 }
+
+// ============================================================
+// Variantes sur clé précalculée : contextes de réduction de p et q,
+// découpes de dp et dq et qinv dans le domaine de p sont déjà prêts
+// ============================================================
+RsaPrivateKey keyGen_crt(unsigned long bits, gmp_randclass& rng, PrimePool* pool) {
+    mpz_class n, e, d, p, q, phi, dp, dq, qinv;
+    keyGen_crt(bits, rng, n, e, d, p, q, phi, dp, dq, qinv, pool);
+    return RsaPrivateKey(n, e, d, p, q, dp, dq, qinv);
+}
+
+void dec_crt(string& m, const mpz_class& c, const RsaPrivateKey& key, bool parallel) {
+    ScratchArena::Frame frame;
+    mpz_class& r = frame.num();
+    key.pow(r, c, parallel);
+    numToString(m, r);
+}
+
+void sing_crt(mpz_class& signature, const string& message,
+              const RsaPrivateKey& key, bool parallel) {
+    ScratchArena::Frame frame;
+    mpz_class& m_num = frame.num();
+    stringToNum(m_num, message);
+    key.pow(signature, m_num, parallel);
+}
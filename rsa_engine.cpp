@@ -0,0 +1,197 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa_key.h"
+#include "lib/rsa_engine.h"
+
+using namespace std;
+
+namespace {
+
+// Copie privée d'un worker : rien n'est partagé entre threads
+// sur le chemin critique (GMP n'est pas réentrant sur un même objet)
+// Si la clé est aveuglée, le worker a sa propre réserve (r^e, r^(-1)),
+// amorcée par son flux : pas de verrou commun entre workers.
+struct WorkerState {
+    RsaPrivateKey key;     // copie privée, précalculs compris
+    gmp_randclass rng;     // flux aléatoire propre au worker
+
+    WorkerState(const RsaPrivateKey& k, const mpz_class& seed)
+        : key(k), rng(gmp_randinit_default) {
+        rng.seed(seed);
+        if (key.blinding()) key.enable_blinding(k.blinding_capacity(), rng.get_z_bits(256) | 1);
+    }
+};
+
+using Task = function<void(WorkerState&)>;
+
+struct TaskQueue {
+    mutex m;
+    deque<Task> tasks;
+};
+
+// Worker courant : permet à une tâche de soumettre dans sa propre file
+thread_local const void* tl_engine = nullptr;
+thread_local unsigned tl_worker = 0;
+
+}  // namespace
+
+struct RsaEngine::Impl {
+    explicit Impl(const RsaPrivateKey& k) : key(k) {}
+
+    RsaPrivateKey key;
+    vector<unique_ptr<TaskQueue>> queues;
+    vector<thread> workers;
+
+    mutex sleep_m;
+    condition_variable cv;
+    atomic<size_t> pending{0};
+    atomic<unsigned> next{0};
+    bool stop = false;
+
+    // pending est modifié sous le verrou de la file, avec la tâche : un
+    // retrait ne peut pas le décrémenter avant l'ajout correspondant.
+    // Le passage par sleep_m ordonne l'ajout avant le réveil (un worker
+    // qui teste pending sous ce verrou voit la tâche ou reçoit le signal).
+    void push(Task t) {
+        unsigned i = (tl_engine == this) ? tl_worker
+                                         : next.fetch_add(1, memory_order_relaxed) % queues.size();
+        {
+            lock_guard<mutex> lk(queues[i]->m);
+            queues[i]->tasks.push_back(move(t));
+            pending.fetch_add(1, memory_order_release);
+        }
+        { lock_guard<mutex> lk(sleep_m); }
+        cv.notify_one();
+    }
+
+    // Sa propre file par l'arrière (LIFO, données encore en cache),
+    // celles des autres par l'avant (FIFO, les tâches les plus anciennes)
+    bool pop(unsigned i, Task& t) {
+        {
+            TaskQueue& own = *queues[i];
+            lock_guard<mutex> lk(own.m);
+            if (!own.tasks.empty()) {
+                t = move(own.tasks.back());
+                own.tasks.pop_back();
+                pending.fetch_sub(1, memory_order_acq_rel);
+                return true;
+            }
+        }
+        for (size_t k = 1; k < queues.size(); ++k) {
+            TaskQueue& victim = *queues[(i + k) % queues.size()];
+            lock_guard<mutex> lk(victim.m);
+            if (!victim.tasks.empty()) {
+                t = move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending.fetch_sub(1, memory_order_acq_rel);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(unsigned i, const mpz_class& seed) {
+        tl_engine = this;
+        tl_worker = i;
+        WorkerState state(key, seed);
+
+        Task t;
+        while (true) {
+            if (pop(i, t)) {
+                t(state);
+                continue;
+            }
+            unique_lock<mutex> lk(sleep_m);
+            cv.wait(lk, [this] { return stop || pending.load(memory_order_acquire) > 0; });
+            if (stop && pending.load(memory_order_acquire) == 0) return;
+        }
+    }
+
+    template <typename R, typename F>
+    future<R> submit(F f) {
+        auto pr = make_shared<promise<R>>();
+        future<R> fut = pr->get_future();
+        push([pr, f](WorkerState& w) {
+            try {
+                pr->set_value(f(w));
+            } catch (...) {
+                pr->set_exception(current_exception());
+            }
+        });
+        return fut;
+    }
+};
+
+RsaEngine::RsaEngine(const RsaPrivateKey& key, unsigned threads, unsigned long seed)
+    : impl_(new Impl(key)) {
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+
+    for (unsigned i = 0; i < threads; ++i) {
+        impl_->queues.emplace_back(new TaskQueue);
+    }
+    // seed = 0 : 256 bits de random_device par worker (les flux servent
+    // à l'aveuglement, ils doivent être imprévisibles)
+    random_device rd;
+    for (unsigned i = 0; i < threads; ++i) {
+        mpz_class s = seed;
+        if (seed == 0) {
+            for (int j = 0; j < 8; ++j) s = (s << 32) | rd();
+        } else {
+            s += i;
+        }
+        impl_->workers.emplace_back([this, i, s] { impl_->run(i, s); });
+    }
+}
+
+RsaEngine::~RsaEngine() {
+    {
+        lock_guard<mutex> lk(impl_->sleep_m);
+        impl_->stop = true;
+    }
+    impl_->cv.notify_all();
+    for (auto& t : impl_->workers) t.join();
+}
+
+unsigned RsaEngine::threads() const {
+    return static_cast<unsigned>(impl_->workers.size());
+}
+
+future<mpz_class> RsaEngine::sign(string message) {
+    return impl_->submit<mpz_class>([message](WorkerState& w) {
+        mpz_class m_num;
+        stringToNum(m_num, message);
+        return w.key.pow(m_num);
+    });
+}
+
+future<string> RsaEngine::decrypt(mpz_class c) {
+    return impl_->submit<string>([c](WorkerState& w) {
+        string m;
+        numToString(m, w.key.pow(c));
+        return m;
+    });
+}
+
+future<mpz_class> RsaEngine::encrypt(string message) {
+    return impl_->submit<mpz_class>([message](WorkerState& w) {
+        mpz_class m_num;
+        stringToNum(m_num, message);
+        return w.key.public_key().pow(m_num);
+    });
+}
+
+future<bool> RsaEngine::verify(mpz_class signature, string message) {
+    return impl_->submit<bool>([signature, message](WorkerState& w) {
+        mpz_class m_num;
+        stringToNum(m_num, message);
+        return w.key.public_key().pow(signature) == m_num;
+    });
+}
@@ -0,0 +1,47 @@
+#include "lib/rsa_key.h"
+#include "lib/arena.h"
+#include "lib/blinding.h"
+
+using namespace std;
+
+RsaPublicKey::RsaPublicKey(const mpz_class& n, const mpz_class& e)
+    : n_(n), e_(e), f4_(e == 65537), mn_(n), e_plan_(window_plan(e)),
+      lanes_(make_shared<const LaneModulus>(n)) {}
+
+RsaPrivateKey::RsaPrivateKey(const mpz_class& n, const mpz_class& e, const mpz_class& d,
+                             const mpz_class& p, const mpz_class& q,
+                             const mpz_class& dp, const mpz_class& dq,
+                             const mpz_class& qinv)
+    : pub_(n, e), d_(d), p_(p), q_(q), dp_(dp), dq_(dq), qinv_(qinv),
+      crt_(p, q, qinv), dp_plan_(window_plan(dp)), dq_plan_(window_plan(dq)) {}
+
+void RsaPrivateKey::enable_blinding(size_t capacity, const mpz_class& seed) {
+    blinding_ = make_shared<BlindingPool>(pub_, capacity, seed);
+}
+
+size_t RsaPrivateKey::blinding_capacity() const {
+    return blinding_ ? blinding_->capacity() : 0;
+}
+
+void RsaPrivateKey::pow_crt(mpz_class& r, const mpz_class& x, bool parallel) const {
+    if (consttime_) crt_.pow_consttime(r, x, dp_, dq_, parallel);
+    // Sans second coeur, les deux moitiés de front sur les voies vectorielles
+    else if (!parallel && crt_.lanes()) crt_.pow(r, x, dp_, dq_);
+    else crt_.pow(r, x, dp_plan_, dq_plan_, parallel);
+}
+
+void RsaPrivateKey::pow(mpz_class& r, const mpz_class& x, bool parallel) const {
+    if (!blinding_) {
+        pow_crt(r, x, parallel);
+        return;
+    }
+
+    // x^d = (x * r^e)^d * r^(-1) : deux multiplications de plus
+    ScratchArena::Frame frame;
+    mpz_class& re = frame.num();
+    mpz_class& rinv = frame.num();
+    mpz_class& y = frame.num();
+    blinding_->take(re, rinv);
+    pow_crt(y, blinding_->mul(x, re), parallel);
+    r = blinding_->mul(y, rinv);
+}
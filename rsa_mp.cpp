@@ -0,0 +1,223 @@
+#include <future>
+#include <stdexcept>
+#include <gmpxx.h>
+#include "lib/arena.h"
+#include "lib/base.h"
+#include "lib/prime_lib.h"
+#include "lib/op_mod.h"
+#include "lib/rsa_mp.h"
+
+using namespace std;
+
+// ============================================================
+// KeyGen multi-premiers
+//   r_0 ... r_(k-2) : bits/k bits, le reste réparti sur les premiers.
+//   genAlea ne fixant que le bit de poids fort, leur produit P vaut
+//   f * 2^(L-1) avec 1 <= f < 2 ; le dernier facteur prend L' bits avec
+//     L' = bits - L + 1 si f < 4/3 : n >= 2^(bits-1) toujours,
+//                                   n < 2^bits avec probabilité 2/f - 1
+//     L' = bits - L     sinon     : n < 2^bits toujours,
+//                                   n >= 2^(bits-1) avec probabilité 2 - 2/f
+//   soit au moins une chance sur deux par tirage du dernier facteur.
+// ============================================================
+void keyGen_mp(unsigned long bits, unsigned int k, gmp_randclass& rng,
+               mpz_class& n, mpz_class& e, mpz_class& d,
+               vector<mpz_class>& primes,
+               vector<mpz_class>& exps,
+               vector<mpz_class>& coeffs) {
+    if (k < 2 || k > 4) throw runtime_error("keyGen_mp: k doit valoir 2, 3 ou 4");
+    if (bits / k < 64) throw runtime_error("keyGen_mp: facteurs de moins de 64 bits");
+
+    auto distinct = [&](const mpz_class& r) {
+        for (const auto& x : primes) if (x == r) return false;
+        return true;
+    };
+
+    primes.clear();
+    mpz_class prod = 1;
+    for (unsigned int i = 0; i + 1 < k; ++i) {
+        mpz_class r;
+        do r = genAlea(rng, bits / k + (i < bits % k)); while (!distinct(r));
+        primes.push_back(r);
+        prod *= r;
+    }
+
+    unsigned long L = mpz_sizeinbase(prod.get_mpz_t(), 2);
+    mpz_class f_scaled = prod * 3;                        // f < 4/3  <=>  3P < 2^(L+1)
+    unsigned long last = bits - L + (f_scaled < (mpz_class(1) << (L + 1)) ? 1 : 0);
+    mpz_class r;
+    do {
+        r = genAlea(rng, last);
+        n = prod * r;
+    } while (!distinct(r) || mpz_sizeinbase(n.get_mpz_t(), 2) != bits);
+    primes.push_back(r);
+
+    mpz_class phi = 1;
+    for (const auto& r : primes) phi *= r - 1;
+
+    e = 65537;
+    while (op_pgcd(e, phi) != 1) {
+        e += 2;
+    }
+
+    d = invmod(e, phi);
+    if (d == 0) {
+        throw runtime_error("Failed to compute modular inverse for d");
+    }
+
+    // Exposants et coefficients de Garner
+    exps.assign(k, 0);
+    coeffs.assign(k, 0);
+    mpz_class prefix = 1;
+    for (unsigned int i = 0; i < k; ++i) {
+        exps[i]   = modulo(d, primes[i] - 1);
+        coeffs[i] = (i == 0) ? mpz_class(1) : invmod(modulo(prefix, primes[i]), primes[i]);
+        prefix *= primes[i];
+    }
+}
+
+// ============================================================
+// Exponentiations indépendantes : en mode parallèle, les k-1 premières
+// sur des threads, la dernière sur l'appelant
+// ============================================================
+static vector<mpz_class> mp_factors(const mpz_class& x,
+                                    const vector<mpz_class>& primes,
+                                    const vector<mpz_class>& exps, bool parallel) {
+    size_t k = primes.size();
+    vector<mpz_class> m(k);
+    if (!parallel) {
+        for (size_t i = 0; i < k; ++i) m[i] = mod_exp_window(x, exps[i], primes[i]);
+        return m;
+    }
+    vector<future<mpz_class>> parts;
+    for (size_t i = 0; i + 1 < k; ++i) {
+        parts.push_back(async(launch::async, [&, i] { return mod_exp_window(x, exps[i], primes[i]); }));
+    }
+    m[k - 1] = mod_exp_window(x, exps[k - 1], primes[k - 1]);
+    for (size_t i = 0; i + 1 < k; ++i) m[i] = parts[i].get();
+    return m;
+}
+
+// Garner : y = m_0, puis y += (r_0 ... r_(i-1)) * (t_i * (m_i - y) mod r_i)
+static mpz_class mp_combine(const vector<mpz_class>& m,
+                            const vector<mpz_class>& primes,
+                            const vector<mpz_class>& coeffs) {
+    mpz_class y = m[0], prefix = primes[0];
+    for (size_t i = 1; i < primes.size(); ++i) {
+        mpz_class diff = m[i] - modulo(y, primes[i]);
+        if (diff < 0) diff += primes[i];
+        y += prefix * modulo(coeffs[i] * diff, primes[i]);
+        prefix *= primes[i];
+    }
+    return y;
+}
+
+void dec_mp(string& m, const mpz_class& c,
+            const vector<mpz_class>& primes,
+            const vector<mpz_class>& exps,
+            const vector<mpz_class>& coeffs, bool parallel) {
+    numToString(m, mp_combine(mp_factors(c, primes, exps, parallel), primes, coeffs));
+}
+
+void sing_mp(mpz_class& signature, const string& message,
+             const vector<mpz_class>& primes,
+             const vector<mpz_class>& exps,
+             const vector<mpz_class>& coeffs, bool parallel) {
+    mpz_class m_num;
+    stringToNum(m_num, message);
+    signature = mp_combine(mp_factors(m_num, primes, exps, parallel), primes, coeffs);
+}
+
+// ============================================================
+// Clé précalculée
+// ============================================================
+RsaMultiPrimeKey::RsaMultiPrimeKey(const mpz_class& n, const mpz_class& e, const mpz_class& d,
+                                   const vector<mpz_class>& primes)
+    : pub_(n, e), d_(d), primes_(primes) {
+    if (primes_.size() < 2) throw runtime_error("RsaMultiPrimeKey: au moins deux facteurs");
+
+    mpz_class prefix = 1;
+    for (const auto& r : primes_) {
+        ctx_.emplace_back(r);
+        const MontgomeryContext& mc = ctx_.back();
+
+        exps_.push_back(modulo(d, r - 1));
+        plans_.push_back(window_plan(exps_.back()));
+        coeffs_.push_back(prefix == 1 ? mpz_class(1) : invmod(modulo(prefix, r), r));
+        if (coeffs_.back() == 0) throw runtime_error("RsaMultiPrimeKey: facteurs non premiers entre eux");
+        coeffs_m_.push_back(mc.to_mont(coeffs_.back()));
+        prefix_.push_back(prefix);
+        prefix *= r;
+    }
+    if (prefix != n) throw runtime_error("RsaMultiPrimeKey: le produit des facteurs n'est pas n");
+}
+
+void RsaMultiPrimeKey::pow_factor(mpz_class& r, const mpz_class& x, size_t i) const {
+    if (consttime_) ctx_[i].exp_consttime(r, x, exps_[i]);
+    else ctx_[i].exp(r, x, plans_[i]);
+}
+
+// Un pas de Garner dans le domaine du facteur i : y mod r_i par
+// repliements REDC (enter), puis h = REDC(t_i*R * (m_i - y)) = t_i * (m_i - y)
+// mod r_i et y += r_0 ... r_(i-1) * h
+void RsaMultiPrimeKey::garner(mpz_class& y, const mpz_class& mi, size_t i) const {
+    const MontgomeryContext& mc = ctx_[i];
+    ScratchArena::Frame frame;
+    mpz_class& h = frame.num();
+    mc.enter(h, y);
+    mc.redc(h, h);
+    mpz_sub(h.get_mpz_t(), mi.get_mpz_t(), h.get_mpz_t());
+    if (h < 0) mpz_add(h.get_mpz_t(), h.get_mpz_t(), primes_[i].get_mpz_t());
+    mc.mul(h, coeffs_m_[i], h);
+    mpz_addmul(y.get_mpz_t(), prefix_[i].get_mpz_t(), h.get_mpz_t());
+}
+
+void RsaMultiPrimeKey::pow(mpz_class& r, const mpz_class& x, bool parallel) const {
+    size_t k = primes_.size();
+    if (!parallel) {
+        // Facteur par facteur, chaque résultat aussitôt recombiné : tout
+        // reste dans l'arène du thread
+        ScratchArena::Frame frame(mpz_sizeinbase(pub_.n().get_mpz_t(), 2));
+        mpz_class& y = frame.num();
+        mpz_class& mi = frame.num();
+        pow_factor(y, x, 0);
+        for (size_t i = 1; i < k; ++i) {
+            pow_factor(mi, x, i);
+            garner(y, mi, i);
+        }
+        r = y;
+        return;
+    }
+
+    vector<mpz_class> m(k);
+    vector<future<void>> parts;
+    for (size_t i = 0; i + 1 < k; ++i) {
+        parts.push_back(async(launch::async, [&, i] { pow_factor(m[i], x, i); }));
+    }
+    pow_factor(m[k - 1], x, k - 1);
+    for (auto& part : parts) part.get();
+    for (size_t i = 1; i < k; ++i) garner(m[0], m[i], i);
+    r = m[0];
+}
+
+RsaMultiPrimeKey keyGen_mp(unsigned long bits, unsigned int k, gmp_randclass& rng) {
+    mpz_class n, e, d;
+    vector<mpz_class> primes, exps, coeffs;
+    keyGen_mp(bits, k, rng, n, e, d, primes, exps, coeffs);
+    return RsaMultiPrimeKey(n, e, d, primes);
+}
+
+void dec_mp(string& m, const mpz_class& c, const RsaMultiPrimeKey& key, bool parallel) {
+    ScratchArena::Frame frame;
+    mpz_class& r = frame.num();
+    key.pow(r, c, parallel);
+    numToString(m, r);
+}
+
+void sing_mp(mpz_class& signature, const string& message,
+             const RsaMultiPrimeKey& key, bool parallel) {
+    ScratchArena::Frame frame;
+    mpz_class& m_num = frame.num();
+    stringToNum(m_num, message);
+    key.pow(signature, m_num, parallel);
+}
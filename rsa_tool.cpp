@@ -0,0 +1,323 @@
+// ============================================================
+// rsa_tool — signature / vérification en lot, non interactif
+//
+//   rsa_tool keygen <bits> <clé_privée> <clé_publique>
+//   rsa_tool sign   <clé_privée>  <manifeste>  <sortie> [-j N]
+//   rsa_tool verify <clé_publique> <signatures> <sortie> [-j N]
+//
+// Manifeste : un chemin de fichier par ligne.
+// Signatures (sortie de sign, entrée de verify) : une ligne par fichier,
+//   "<signature hex sur 2k chiffres> <chemin>"
+// Sortie de verify : "OK <chemin>", "FAIL <chemin>" ou
+//   "ERROR <chemin>: <raison>", dans l'ordre du manifeste.
+// Code de retour : 0 si tout est signé / valide, 1 sinon, 2 pour un
+// usage incorrect.
+//
+// Chaque fichier est projeté en mémoire (mmap), haché (SHA-256), encodé
+// EMSA-PKCS1-v1_5 puis signé par sing_crt ou vérifié par verify_batch
+// (par paquets de 8, voir MontLanes).
+// Les fichiers sont répartis sur N threads (un par coeur par défaut),
+// chacun avec sa propre copie de la clé précalculée.
+// Fichiers de clés : une ligne "<nom> <valeur hex>" par paramètre
+// (n, e pour la clé publique ; n, e, d, p, q, dp, dq, qinv pour la privée).
+// ============================================================
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "lib/base.h"
+#include "lib/rsa.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "lib/rsa_batch.h"
+#include "lib/sha256.h"
+
+using namespace std;
+
+// ------------------------------------------------------------
+// Fichiers de clés
+// ------------------------------------------------------------
+static map<string, mpz_class> read_key_file(const string& path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("impossible d'ouvrir " + path);
+    map<string, mpz_class> fields;
+    string name, hex;
+    while (in >> name >> hex) {
+        mpz_class v;
+        if (v.set_str(hex, 16) != 0) throw runtime_error(path + ": valeur invalide pour " + name);
+        fields[name] = v;
+    }
+    return fields;
+}
+
+static const mpz_class& field(const map<string, mpz_class>& f, const string& name) {
+    auto it = f.find(name);
+    if (it == f.end()) throw runtime_error("paramètre manquant dans la clé : " + name);
+    return it->second;
+}
+
+static RsaPublicKey load_public_key(const string& path) {
+    auto f = read_key_file(path);
+    return RsaPublicKey(field(f, "n"), field(f, "e"));
+}
+
+static RsaPrivateKey load_private_key(const string& path) {
+    auto f = read_key_file(path);
+    return RsaPrivateKey(field(f, "n"), field(f, "e"), field(f, "d"),
+                         field(f, "p"), field(f, "q"),
+                         field(f, "dp"), field(f, "dq"), field(f, "qinv"));
+}
+
+// mode : droits du fichier, appliqués avant d'écrire quoi que ce soit
+// (0600 pour la clé privée ; fchmod aussi si le fichier existait déjà)
+static void write_key_file(const string& path, const vector<pair<string, mpz_class>>& fields,
+                           mode_t mode) {
+    string text;
+    for (const auto& kv : fields) text += kv.first + " " + kv.second.get_str(16) + "\n";
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, mode);
+    if (fd < 0) throw runtime_error("impossible de créer " + path + " : " + strerror(errno));
+    if (fchmod(fd, mode) != 0) {
+        int err = errno;
+        close(fd);
+        throw runtime_error("droits de " + path + " : " + strerror(err));
+    }
+    for (size_t done = 0; done < text.size();) {
+        ssize_t w = write(fd, text.data() + done, text.size() - done);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            int err = errno;
+            close(fd);
+            throw runtime_error("erreur d'écriture " + path + " : " + strerror(err));
+        }
+        done += static_cast<size_t>(w);
+    }
+    if (close(fd) != 0) throw runtime_error("erreur d'écriture " + path + " : " + strerror(errno));
+}
+
+// ------------------------------------------------------------
+// Empreinte d'un fichier projeté en mémoire
+// ------------------------------------------------------------
+static void hash_file(std::byte digest[Sha256::DIGEST], const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error(strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        throw runtime_error(strerror(err));
+    }
+
+    size_t len = static_cast<size_t>(st.st_size);
+    if (len == 0) {   // mmap refuse une longueur nulle
+        close(fd);
+        sha256(digest, nullptr, 0);
+        return;
+    }
+    void* map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) throw runtime_error(strerror(errno));
+    madvise(map, len, MADV_SEQUENTIAL);
+    sha256(digest, static_cast<const std::byte*>(map), len);
+    munmap(map, len);
+}
+
+// EMSA-PKCS1-v1_5 (RFC 8017, §9.2) : 00 01 FF..FF 00 || DigestInfo || H
+// sur k octets, rendu sous forme de chaîne pour sing_crt / verify
+static string emsa_pkcs1_sha256(const std::byte digest[Sha256::DIGEST], size_t k) {
+    static const unsigned char DIGEST_INFO[] = {
+        0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+        0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20};
+    const size_t t = sizeof(DIGEST_INFO) + Sha256::DIGEST;
+    if (k < t + 11) throw runtime_error("module RSA trop petit pour EMSA-PKCS1-v1_5");
+
+    string em(k, '\xff');
+    em[0] = '\x00';
+    em[1] = '\x01';
+    em[k - t - 1] = '\x00';
+    memcpy(&em[k - t], DIGEST_INFO, sizeof(DIGEST_INFO));
+    memcpy(&em[k - Sha256::DIGEST], digest, Sha256::DIGEST);
+    return em;
+}
+
+static size_t modulus_bytes(const mpz_class& n) {
+    return (mpz_sizeinbase(n.get_mpz_t(), 2) + 7) / 8;
+}
+
+// ------------------------------------------------------------
+// Répartition d'un lot de tâches indépendantes sur N threads
+// ------------------------------------------------------------
+template <typename Job>
+static void parallel_for(size_t count, unsigned threads, Job job) {
+    atomic<size_t> next(0);
+    auto worker = [&](unsigned t) {
+        for (size_t i; (i = next.fetch_add(1, memory_order_relaxed)) < count;) job(t, i);
+    };
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+}
+
+static vector<string> read_lines(const string& path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("impossible d'ouvrir " + path);
+    vector<string> lines;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) lines.push_back(line);
+    }
+    return lines;
+}
+
+static void write_lines(const string& path, const vector<string>& lines) {
+    ofstream out(path, ios::trunc);
+    if (!out) throw runtime_error("impossible de créer " + path);
+    for (const string& l : lines) out << l << '\n';
+    if (!out) throw runtime_error("erreur d'écriture " + path);
+}
+
+// ------------------------------------------------------------
+// Sous-commandes
+// ------------------------------------------------------------
+static int cmd_keygen(unsigned long bits, const string& priv_path, const string& pub_path) {
+    // 256 bits de la source du système : p et q ne valent pas mieux que la graine
+    random_device rd;
+    mpz_class seed = 0;
+    for (int i = 0; i < 8; ++i) seed = (seed << 32) | rd();
+    gmp_randclass rng(gmp_randinit_default);
+    rng.seed(seed);
+
+    RsaPrivateKey key = keyGen_crt(bits, rng);
+    write_key_file(priv_path, {{"n", key.n()}, {"e", key.e()}, {"d", key.d()},
+                               {"p", key.p()}, {"q", key.q()},
+                               {"dp", key.dp()}, {"dq", key.dq()}, {"qinv", key.qinv()}},
+                   0600);
+    write_key_file(pub_path, {{"n", key.n()}, {"e", key.e()}}, 0644);
+    return 0;
+}
+
+static int cmd_sign(const string& key_path, const string& manifest, const string& out_path,
+                    unsigned threads) {
+    const RsaPrivateKey key = load_private_key(key_path);
+    const size_t k = modulus_bytes(key.n());
+    const vector<string> files = read_lines(manifest);
+
+    // Une copie de la clé par thread (contextes et découpes précalculés)
+    vector<RsaPrivateKey> keys(threads, key);
+    vector<string> results(files.size());
+    atomic<bool> failed(false);
+
+    parallel_for(files.size(), threads, [&](unsigned t, size_t i) {
+        try {
+            std::byte digest[Sha256::DIGEST];
+            hash_file(digest, files[i]);
+            mpz_class sig;
+            sing_crt(sig, emsa_pkcs1_sha256(digest, k), keys[t]);
+
+            string hex = sig.get_str(16);
+            results[i] = string(2 * k - hex.size(), '0') + hex + " " + files[i];
+        } catch (const exception& e) {
+            results[i] = "ERROR " + files[i] + ": " + e.what();
+            failed.store(true, memory_order_relaxed);
+        }
+    });
+
+    write_lines(out_path, results);
+    return failed ? 1 : 0;
+}
+
+static int cmd_verify(const string& key_path, const string& sig_path, const string& out_path,
+                      unsigned threads) {
+    const RsaPublicKey key = load_public_key(key_path);
+    const size_t k = modulus_bytes(key.n());
+    const vector<string> lines = read_lines(sig_path);
+
+    vector<RsaPublicKey> keys(threads, key);
+    vector<string> results(lines.size());
+    atomic<bool> failed(false);
+
+    // Paquets de MontLanes::LANES lignes : les signatures valides d'un
+    // paquet sont vérifiées ensemble (verify_batch)
+    const size_t lanes = MontLanes::LANES;
+    parallel_for((lines.size() + lanes - 1) / lanes, threads, [&](unsigned t, size_t chunk) {
+        vector<size_t> idx;
+        vector<mpz_class> sigs;
+        vector<string> msgs;
+        for (size_t i = chunk * lanes; i < min(lines.size(), (chunk + 1) * lanes); ++i) {
+            const string& line = lines[i];
+            size_t sp = line.find(' ');
+            string path = sp == string::npos ? line : line.substr(sp + 1);
+            try {
+                mpz_class sig;
+                if (sp == string::npos || sig.set_str(line.substr(0, sp), 16) != 0)
+                    throw runtime_error("ligne de signature invalide");
+
+                std::byte digest[Sha256::DIGEST];
+                hash_file(digest, path);
+                idx.push_back(i);
+                sigs.push_back(sig);
+                msgs.push_back(emsa_pkcs1_sha256(digest, k));
+                results[i] = path;
+            } catch (const exception& e) {
+                results[i] = "ERROR " + path + ": " + e.what();
+                failed.store(true, memory_order_relaxed);
+            }
+        }
+
+        vector<bool> ok;
+        verify_batch(ok, sigs, msgs, vector<const RsaPublicKey*>(sigs.size(), &keys[t]));
+        for (size_t j = 0; j < idx.size(); ++j) {
+            results[idx[j]] = (ok[j] ? "OK " : "FAIL ") + results[idx[j]];
+            if (!ok[j]) failed.store(true, memory_order_relaxed);
+        }
+    });
+
+    write_lines(out_path, results);
+    return failed ? 1 : 0;
+}
+
+static int usage() {
+    cerr << "usage:\n"
+            "  rsa_tool keygen <bits> <clé_privée> <clé_publique>\n"
+            "  rsa_tool sign   <clé_privée>  <manifeste>  <sortie> [-j N]\n"
+            "  rsa_tool verify <clé_publique> <signatures> <sortie> [-j N]\n";
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    vector<string> args(argv + 1, argv + argc);
+
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "-j" && i + 1 < args.size()) {
+            threads = static_cast<unsigned>(max(1, atoi(args[i + 1].c_str())));
+            args.erase(args.begin() + i, args.begin() + i + 2);
+            break;
+        }
+    }
+
+    try {
+        if (args.size() == 4 && args[0] == "keygen")
+            return cmd_keygen(stoul(args[1]), args[2], args[3]);
+        if (args.size() == 4 && args[0] == "sign")
+            return cmd_sign(args[1], args[2], args[3], threads);
+        if (args.size() == 4 && args[0] == "verify")
+            return cmd_verify(args[1], args[2], args[3], threads);
+    } catch (const exception& e) {
+        cerr << "rsa_tool: " << e.what() << endl;
+        return 1;
+    }
+    return usage();
+}
@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include "lib/base.h"
+#include "lib/chacha20.h"
+#include "lib/sha256.h"
+#include "lib/stream.h"
+
+using namespace std;
+
+static const char MAGIC[4] = {'R', 'S', 'A', 'S'};
+static const std::byte VERSION{1};
+static const size_t HEADER_FIXED = 7;         // magic + version + k
+static const size_t PAYLOAD = 32 + 7;         // clé de session + préfixe de nonce
+static const size_t TAG = 16;
+
+// Octets aléatoires pour la clé de session et le bourrage
+// (random_device : source du système, pas le générateur de GMP)
+static void random_bytes(std::byte* out, size_t len) {
+    random_device rd;
+    for (size_t i = 0; i < len; i += 4) {
+        uint32_t v = rd();
+        memcpy(out + i, &v, min<size_t>(4, len - i));
+    }
+}
+
+static void wipe(std::byte* p, size_t len) {
+    volatile std::byte* v = p;
+    while (len--) *v++ = std::byte{0};
+}
+
+// Masques sans branchement : tous les bits à 1 si la condition est vraie
+static inline uint64_t ct_mask_zero(uint64_t x) { return ((x | (0 - x)) >> 63) - 1; }
+static inline uint64_t ct_mask_eq(uint64_t a, uint64_t b) { return ct_mask_zero(a ^ b); }
+
+// HMAC-SHA256 (RFC 2104) de data || label, clé de 32 octets
+static void hmac_sha256(std::byte out[Sha256::DIGEST], const std::byte key[32],
+                        const std::byte* data, size_t len, std::byte label) {
+    std::byte pad[64];
+    Sha256 inner, outer;
+    for (size_t i = 0; i < 64; ++i) pad[i] = (i < 32 ? key[i] : std::byte{0}) ^ std::byte{0x36};
+    inner.update(pad, 64);
+    inner.update(data, len);
+    inner.update(&label, 1);
+    inner.finish(out);
+    for (size_t i = 0; i < 64; ++i) pad[i] = (i < 32 ? key[i] : std::byte{0}) ^ std::byte{0x5c};
+    outer.update(pad, 64);
+    outer.update(out, Sha256::DIGEST);
+    outer.finish(out);
+    wipe(pad, sizeof(pad));
+}
+
+static size_t modulus_bytes(const mpz_class& n) {
+    return (mpz_sizeinbase(n.get_mpz_t(), 2) + 7) / 8;
+}
+
+// nonce = préfixe (7) || numéro de segment (4, big-endian) || dernier (1)
+static void segment_nonce(std::byte nonce[12], const std::byte prefix[7], uint32_t counter, bool last) {
+    memcpy(nonce, prefix, 7);
+    nonce[7]  = std::byte(counter >> 24);
+    nonce[8]  = std::byte(counter >> 16);
+    nonce[9]  = std::byte(counter >> 8);
+    nonce[10] = std::byte(counter);
+    nonce[11] = std::byte(last ? 1 : 0);
+}
+
+// ============================================================
+// Chiffrement
+// ============================================================
+StreamEncryptor::StreamEncryptor(const RsaPublicKey& key) {
+    size_t k = modulus_bytes(key.n());
+    if (k < PAYLOAD + 11) throw runtime_error("stream: module RSA trop petit");
+    if (k > 0xFFFF) throw runtime_error("stream: module RSA trop grand");
+
+    random_bytes(key_, sizeof(key_));
+    random_bytes(prefix_, sizeof(prefix_));
+
+    // EM = 00 || 02 || PS (non nuls, >= 8 octets) || 00 || clé || préfixe
+    vector<std::byte> em(k);
+    size_t ps = k - 3 - PAYLOAD;
+    em[0] = std::byte{0};
+    em[1] = std::byte{2};
+    random_bytes(&em[2], ps);
+    for (size_t i = 2; i < 2 + ps; ++i) {
+        while (em[i] == std::byte{0}) random_bytes(&em[i], 1);
+    }
+    em[2 + ps] = std::byte{0};
+    memcpy(&em[3 + ps], key_, 32);
+    memcpy(&em[3 + ps + 32], prefix_, 7);
+
+    mpz_class m;
+    bytesToNum(m, em.data(), k);
+    wipe(em.data(), k);
+    mpz_class c = key.pow(m);
+
+    header_.resize(HEADER_FIXED + k);
+    memcpy(header_.data(), MAGIC, 4);
+    header_[4] = VERSION;
+    header_[5] = std::byte(k >> 8);
+    header_[6] = std::byte(k);
+    numToBytesFixed(&header_[HEADER_FIXED], k, c);
+
+    buf_.reserve(SEGMENT);
+}
+
+void StreamEncryptor::seal(bool last, vector<std::byte>& out) {
+    if (counter_ == UINT32_MAX) throw runtime_error("stream: message trop long");
+    std::byte nonce[12];
+    segment_nonce(nonce, prefix_, counter_++, last);
+
+    size_t len = buf_.size(), pos = out.size();
+    out.resize(pos + len + TAG);
+    aead_seal(&out[pos], &out[pos + len], key_, nonce,
+              header_.data(), header_.size(), buf_.data(), len);
+    buf_.clear();
+}
+
+void StreamEncryptor::update(const std::byte* data, size_t len, vector<std::byte>& out) {
+    if (done_) throw runtime_error("stream: flux déjà finalisé");
+    if (!header_sent_) {
+        out.insert(out.end(), header_.begin(), header_.end());
+        header_sent_ = true;
+    }
+    while (len > 0) {
+        // Un segment plein n'est scellé que si d'autres octets suivent :
+        // le dernier segment doit porter le drapeau
+        if (buf_.size() == SEGMENT) seal(false, out);
+        size_t take = min(SEGMENT - buf_.size(), len);
+        buf_.insert(buf_.end(), data, data + take);
+        data += take;
+        len -= take;
+    }
+}
+
+void StreamEncryptor::finalize(vector<std::byte>& out) {
+    update(nullptr, 0, out);
+    seal(true, out);
+    done_ = true;
+    wipe(key_, sizeof(key_));
+}
+
+// ============================================================
+// Déchiffrement
+// ============================================================
+StreamDecryptor::StreamDecryptor(const RsaPrivateKey& key)
+    : rsa_(key), k_(modulus_bytes(key.n())) {
+    if (k_ < PAYLOAD + 11) throw runtime_error("stream: module RSA trop petit");
+
+    // Secret de rejet propre à la clé : SHA-256(étiquette || d)
+    static const char LABEL[] = "RSAS rejet implicite";
+    vector<std::byte> d(k_);
+    numToBytesFixed(d.data(), k_, key.d());
+    Sha256 h;
+    h.update(reinterpret_cast<const std::byte*>(LABEL), sizeof(LABEL) - 1);
+    h.update(d.data(), k_);
+    h.finish(reject_);
+    wipe(d.data(), k_);
+
+    header_.reserve(HEADER_FIXED + k_);
+    buf_.reserve(StreamEncryptor::SEGMENT + TAG + 1);
+}
+
+// Rejet implicite : un bourrage invalide ne lève pas d'erreur distincte,
+// une clé de repli est utilisée et c'est l'étiquette du premier segment
+// qui échoue (pas d'oracle de bourrage à la Bleichenbacher).
+// Le chemin ne dépend pas de la validité : la clé de repli est toujours
+// calculée (HMAC du chiffré sous le secret de la clé, donc la même pour
+// un même chiffré), les k octets sont tous parcourus et la clé retenue
+// est choisie par masque, à une position fixe (le séparateur doit être
+// en k - 1 - PAYLOAD).
+void StreamDecryptor::unwrap() {
+    if (memcmp(header_.data(), MAGIC, 4) != 0 || header_[4] != VERSION)
+        throw runtime_error("stream: en-tête invalide");
+
+    const std::byte* c_bytes = &header_[HEADER_FIXED];
+    mpz_class c, m;
+    bytesToNum(c, c_bytes, k_);
+    m = rsa_.pow(c);
+
+    std::byte alt_key[Sha256::DIGEST], alt_prefix[Sha256::DIGEST];
+    hmac_sha256(alt_key, reject_, c_bytes, k_, std::byte{0});
+    hmac_sha256(alt_prefix, reject_, c_bytes, k_, std::byte{1});
+
+    vector<std::byte> em(k_);
+    numToBytesFixed(em.data(), k_, m);   // m < n : tient toujours sur k octets
+
+    // Premier octet nul après 00 || 02 : sa position, sans sortie anticipée
+    uint64_t sep = 0, found = 0;
+    for (size_t i = 2; i < k_; ++i) {
+        uint64_t zero = ct_mask_zero((uint64_t)em[i]);
+        sep |= zero & ~found & i;
+        found |= zero;
+    }
+    const size_t at = k_ - PAYLOAD;
+    uint64_t ok = ct_mask_zero((uint64_t)em[0]) & ct_mask_eq((uint64_t)em[1], 2) &
+                  found & ct_mask_eq(sep, at - 1);
+
+    const std::byte keep = std::byte(ok & 0xFF);
+    for (size_t j = 0; j < 32; ++j) key_[j] = (em[at + j] & keep) | (alt_key[j] & ~keep);
+    for (size_t j = 0; j < 7; ++j) prefix_[j] = (em[at + 32 + j] & keep) | (alt_prefix[j] & ~keep);
+
+    wipe(em.data(), k_);
+    wipe(alt_key, sizeof(alt_key));
+    wipe(alt_prefix, sizeof(alt_prefix));
+    have_key_ = true;
+}
+
+void StreamDecryptor::open(const std::byte* seg, size_t len, bool last, vector<std::byte>& out) {
+    if (len < TAG) throw runtime_error("stream: flux tronqué");
+    if (counter_ == UINT32_MAX) throw runtime_error("stream: message trop long");
+    std::byte nonce[12];
+    segment_nonce(nonce, prefix_, counter_++, last);
+
+    size_t ct = len - TAG, pos = out.size();
+    out.resize(pos + ct);
+    if (!aead_open(&out[pos], seg + ct, key_, nonce,
+                   header_.data(), header_.size(), seg, ct)) {
+        out.resize(pos);
+        throw runtime_error("stream: authentification échouée");
+    }
+}
+
+void StreamDecryptor::update(const std::byte* data, size_t len, vector<std::byte>& out) {
+    if (done_) throw runtime_error("stream: flux déjà finalisé");
+
+    // En-tête : taille fixe, puis k octets de clé chiffrée
+    while (!have_key_ && len > 0) {
+        size_t want = header_.size() < HEADER_FIXED ? HEADER_FIXED : HEADER_FIXED + k_;
+        size_t take = min(want - header_.size(), len);
+        header_.insert(header_.end(), data, data + take);
+        data += take;
+        len -= take;
+        if (header_.size() == HEADER_FIXED) {
+            size_t k = ((size_t)header_[5] << 8) | (size_t)header_[6];
+            if (k != k_) throw runtime_error("stream: taille de module inattendue");
+        }
+        if (header_.size() == HEADER_FIXED + k_) unwrap();
+    }
+
+    // Segments : un segment complet n'est ouvert que si au moins un octet
+    // le suit (sinon c'est peut-être le dernier) ; buf_ <= SEGMENT + TAG + 1
+    const size_t full = StreamEncryptor::SEGMENT + TAG;
+    while (len > 0) {
+        size_t take = min(full + 1 - buf_.size(), len);
+        buf_.insert(buf_.end(), data, data + take);
+        data += take;
+        len -= take;
+        if (buf_.size() == full + 1) {
+            open(buf_.data(), full, false, out);
+            buf_[0] = buf_[full];
+            buf_.resize(1);
+        }
+    }
+}
+
+void StreamDecryptor::finalize(vector<std::byte>& out) {
+    if (done_) throw runtime_error("stream: flux déjà finalisé");
+    if (!have_key_) throw runtime_error("stream: flux tronqué");
+    open(buf_.data(), buf_.size(), true, out);
+    buf_.clear();
+    done_ = true;
+    wipe(key_, sizeof(key_));
+}
+
+// ============================================================
+// Fichiers
+// ============================================================
+template <typename Stream>
+static void pump(Stream& s, const string& in_path, ofstream& out) {
+    ifstream in(in_path, ios::binary);
+    if (!in) throw runtime_error("stream: impossible d'ouvrir " + in_path);
+
+    vector<char> ibuf(StreamEncryptor::SEGMENT);
+    vector<std::byte> obuf;
+    obuf.reserve(2 * StreamEncryptor::SEGMENT);
+    while (in) {
+        in.read(ibuf.data(), ibuf.size());
+        size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0) break;
+        obuf.clear();
+        s.update(reinterpret_cast<const std::byte*>(ibuf.data()), got, obuf);
+        out.write(reinterpret_cast<const char*>(obuf.data()), obuf.size());
+    }
+    if (in.bad()) throw runtime_error("stream: erreur de lecture " + in_path);
+    obuf.clear();
+    s.finalize(obuf);
+    out.write(reinterpret_cast<const char*>(obuf.data()), obuf.size());
+    out.flush();
+    if (!out) throw runtime_error("stream: erreur d'écriture");
+}
+
+void encrypt_file(const string& in_path, const string& out_path, const RsaPublicKey& key) {
+    ofstream out(out_path, ios::binary | ios::trunc);
+    if (!out) throw runtime_error("stream: impossible de créer " + out_path);
+    StreamEncryptor enc(key);
+    pump(enc, in_path, out);
+}
+
+void decrypt_file(const string& in_path, const string& out_path, const RsaPrivateKey& key) {
+    ofstream out(out_path, ios::binary | ios::trunc);
+    if (!out) throw runtime_error("stream: impossible de créer " + out_path);
+    try {
+        StreamDecryptor dec(key);
+        pump(dec, in_path, out);
+    } catch (...) {
+        out.close();
+        std::remove(out_path.c_str());
+        throw;
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+
+// ============================================================
+// Mini-harnais des tests, sans dépendance externe
+//   TEST_GROUP(nom) { ... } déclare un groupe, enregistré au démarrage ;
+//   test_main.cpp les exécute (tous, ou celui passé en argument).
+//   CHECK n'interrompt pas le groupe : chaque échec est compté et affiché
+//   avec son fichier et sa ligne.
+// Un fichier tests/test_<sous-système>.cpp par sous-système.
+// ============================================================
+
+struct TestGroup {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestGroup>& test_groups();
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*run)()) { test_groups().push_back({name, run}); }
+};
+
+#define TEST_GROUP(name)                                                   \
+    static void test_group_##name();                                       \
+    static TestRegistrar test_registrar_##name(#name, test_group_##name);  \
+    static void test_group_##name()
+
+inline int g_failures = 0;
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            ++g_failures;                                                  \
+            fprintf(stderr, "%s:%d: échec : %s\n", __FILE__, __LINE__, #cond); \
+        }                                                                  \
+    } while (0)
+
+// Vérifie que l'expression lève une exception du type attendu
+#define CHECK_THROWS(expr, type)                                           \
+    do {                                                                   \
+        bool thrown = false;                                               \
+        try { expr; } catch (const type&) { thrown = true; }               \
+        if (!thrown) {                                                     \
+            ++g_failures;                                                  \
+            fprintf(stderr, "%s:%d: aucune exception : %s\n", __FILE__, __LINE__, #expr); \
+        }                                                                  \
+    } while (0)
+
+// ------------------------------------------------------------
+// Données communes
+// ------------------------------------------------------------
+
+// Graine fixe : un échec se reproduit à l'identique
+inline gmp_randclass& test_rng() {
+    static gmp_randclass rng(gmp_randinit_default);
+    static bool seeded = false;
+    if (!seeded) {
+        rng.seed(20240611);
+        seeded = true;
+    }
+    return rng;
+}
+
+// Clé de 1024 bits partagée par les groupes
+inline const RsaPrivateKey& test_key() {
+    static RsaPrivateKey key = keyGen_crt(1024, test_rng());
+    return key;
+}
+
+// Référence : exponentiation modulaire de GMP
+inline mpz_class powm(const mpz_class& b, const mpz_class& e, const mpz_class& n) {
+    mpz_class r;
+    mpz_powm(r.get_mpz_t(), b.get_mpz_t(), e.get_mpz_t(), n.get_mpz_t());
+    return r;
+}
+
+inline std::vector<std::byte> to_bytes(const char* s) {
+    std::vector<std::byte> v(strlen(s));
+    memcpy(v.data(), s, v.size());
+    return v;
+}
+
+#endif  // TESTS_CHECK_H
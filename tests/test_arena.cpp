@@ -0,0 +1,67 @@
+// Arène de travail par thread : portées, réutilisation, régime établi
+#include <thread>
+#include <gmpxx.h>
+#include "lib/arena.h"
+#include "lib/base.h"
+#include "lib/montgomery.h"
+#include "lib/window.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(arena) {
+    ScratchArena& arena = ScratchArena::local();
+
+    // Une portée rend tout en bloc : la suivante retrouve les mêmes objets
+    mpz_class* first;
+    mp_limb_t* words;
+    {
+        ScratchArena::Frame frame(1024);
+        first = &frame.num();
+        words = frame.limbs(40);
+        *first = 12345;
+        for (size_t i = 0; i < 40; ++i) words[i] = i;   // toute la zone est écrivable
+        {
+            // Portée imbriquée : prend après la portée englobante
+            ScratchArena::Frame inner;
+            CHECK(&inner.num() != first);
+            CHECK(inner.limbs(8) != words);
+        }
+        CHECK(*first == 12345);
+    }
+    {
+        ScratchArena::Frame frame;
+        CHECK(&frame.num() == first);
+        CHECK(frame.limbs(40) == words);
+    }
+
+    // reserve() ne fait que grandir et garde la valeur des entiers
+    {
+        ScratchArena::Frame frame(256);
+        mpz_class& x = frame.num();
+        x = 77;
+        arena.reserve(4096);
+        CHECK(x == 77);
+        CHECK((unsigned long)x.get_mpz_t()->_mp_alloc * GMP_LIMB_BITS >= 2 * 4096);
+    }
+
+    // Régime établi : le même calcul répété ne fait plus grandir l'arène
+    gmp_randclass& rng = test_rng();
+    mpz_class n = rng.get_z_bits(1024) | 1;
+    mpz_setbit(n.get_mpz_t(), 1023);
+    MontgomeryContext mc(n);
+    mpz_class a = rng.get_z_range(n), e = rng.get_z_bits(1024);
+    ExpPlan plan = window_plan(e);
+    mpz_class r = mc.exp(a, plan);
+    size_t nums = arena.nums(), held = arena.words();
+    for (int i = 0; i < 10; ++i) mc.exp(r, a, plan);
+    CHECK(arena.nums() == nums);
+    CHECK(arena.words() == held);
+    CHECK(r == powm(a, e, n));
+
+    // Une arène par thread
+    ScratchArena* other = nullptr;
+    thread t([&] { other = &ScratchArena::local(); });
+    t.join();
+    CHECK(other != &arena);
+}
@@ -0,0 +1,53 @@
+// Réduction de Barrett et modulo() / mulmod() qui s'appuient dessus
+#include <vector>
+#include <gmpxx.h>
+#include "lib/barrett.h"
+#include "lib/base.h"
+#include "lib/op_mod.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// Référence : reste de la division euclidienne, dans [0, n)
+static mpz_class mod_ref(const mpz_class& x, const mpz_class& n) {
+    mpz_class r;
+    mpz_mod(r.get_mpz_t(), x.get_mpz_t(), n.get_mpz_t());
+    return r;
+}
+
+TEST_GROUP(barrett) {
+    gmp_randclass& rng = test_rng();
+
+    for (unsigned long bits : {2ul, 17ul, 64ul, 65ul, 511ul, 1024ul, 2048ul}) {
+        mpz_class n = rng.get_z_bits(bits);
+        mpz_setbit(n.get_mpz_t(), bits - 1);
+        BarrettContext ctx(n);
+        CHECK(ctx.modulus() == n);
+        unsigned long k = (bits + 63) / 64;
+        mpz_class bound = mpz_class(1) << (128 * k);
+
+        for (int i = 0; i < 20; ++i) {
+            mpz_class a = rng.get_z_range(n), b = rng.get_z_range(n);
+            mpz_class x = rng.get_z_range(bound);
+            CHECK(ctx.reduce(x) == mod_ref(x, n));
+            CHECK(ctx.reduce(a * b) == a * b % n);
+
+            mpz_class r = a;
+            ctx.mul(r, r, b);       // en place
+            CHECK(r == a * b % n);
+
+            CHECK(modulo(x, n) == mod_ref(x, n));
+            CHECK(modulo(x, ctx) == mod_ref(x, n));
+            CHECK(mulmod(a, b, n) == a * b % n);
+            CHECK(mulmod(a, b, ctx) == a * b % n);
+        }
+
+        // Bords : 0, n - 1, n, multiples de n, b^(2k) - 1, hors domaine
+        vector<mpz_class> edges = {0, n - 1, n, n * n, n * n - 1, bound - 1,
+                                   bound, bound * 3 + 7, -1, -n * 5 - 2};
+        for (const mpz_class& x : edges) {
+            CHECK(ctx.reduce(x) == mod_ref(x, n));
+            CHECK(modulo(x, ctx) == mod_ref(x, n));
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// Lots : déchiffrement / signature CRT par lot, Batch RSA de Fiat
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa.h"
+#include "lib/rsa_batch.h"
+#include "lib/rsa_crt.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(batch) {
+    const RsaPrivateKey& key = test_key();
+    const mpz_class& p = key.p();
+    const mpz_class& q = key.q();
+    mpz_class phi = (p - 1) * (q - 1);
+
+    // Exposants premiers distincts, premiers avec phi : chemin de Fiat
+    vector<mpz_class> exps;
+    for (unsigned long e = 3; exps.size() < 5; e += 2) {
+        if (mpz_probab_prime_p(mpz_class(e).get_mpz_t(), 30) && gcd(mpz_class(e), phi) == 1) {
+            exps.push_back(e);
+        }
+    }
+    vector<string> msgs = {"un", "deux", "trois", "quatre", "cinq"};
+    vector<mpz_class> c(msgs.size());
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        mpz_class m;
+        stringToNum(m, msgs[i]);
+        c[i] = powm(m, exps[i], key.n());
+    }
+    vector<string> out;
+    dec_batch_fiat(out, c, exps, p, q);
+    CHECK(out == msgs);
+
+    // Exposants non premiers entre eux : repli sur le CRT un à un
+    vector<mpz_class> dup(msgs.size(), key.e());
+    for (size_t i = 0; i < msgs.size(); ++i) enc(c[i], msgs[i], key.public_key());
+    dec_batch_fiat(out, c, dup, p, q);
+    CHECK(out == msgs);
+
+    // Chiffré non inversible modulo n (multiple de p) : repli aussi
+    c[0] = powm(p, exps[0], key.n());
+    for (size_t i = 1; i < msgs.size(); ++i) {
+        mpz_class m;
+        stringToNum(m, msgs[i]);
+        c[i] = powm(m, exps[i], key.n());
+    }
+    dec_batch_fiat(out, c, exps, p, q);
+    for (size_t i = 1; i < msgs.size(); ++i) CHECK(out[i] == msgs[i]);
+    mpz_class back;
+    stringToNum(back, out[0]);
+    CHECK(back == p);
+
+    CHECK_THROWS(dec_batch_fiat(out, c, vector<mpz_class>(2, 3), p, q), invalid_argument);
+    dec_batch_fiat(out, {}, {}, p, q);
+    CHECK(out.empty());
+
+    // Déchiffrement et signature CRT par lot, fonctions libres et clé
+    for (size_t i = 0; i < msgs.size(); ++i) enc(c[i], msgs[i], key.public_key());
+    dec_crt_batch(out, c, p, q, key.dp(), key.dq(), key.qinv());
+    CHECK(out == msgs);
+    dec_crt_batch(out, c, key);
+    CHECK(out == msgs);
+
+    vector<mpz_class> sigs, sigs_key;
+    sing_crt_batch(sigs, msgs, p, q, key.dp(), key.dq(), key.qinv());
+    sing_crt_batch(sigs_key, msgs, key);
+    CHECK(sigs.size() == msgs.size());
+    CHECK(sigs == sigs_key);
+    for (size_t i = 0; i < sigs.size(); ++i) {
+        mpz_class s;
+        sing_crt(s, msgs[i], key);
+        CHECK(sigs[i] == s);
+        CHECK(verify(sigs[i], msgs[i], key.public_key()));
+    }
+}
@@ -0,0 +1,51 @@
+// Aveuglement : réserve de facteurs partagée, combinée au temps constant
+#include <string>
+#include <thread>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(blinding) {
+    const RsaPrivateKey& base = test_key();
+    mpz_class x = test_rng().get_z_range(base.n());
+    mpz_class ref = powm(x, base.d(), base.n());
+
+    for (int mode = 0; mode < 4; ++mode) {
+        RsaPrivateKey key = base;
+        if (mode & 1) key.enable_blinding(8, 12345);
+        key.set_constant_time((mode & 2) != 0);
+        CHECK(key.blinding() == ((mode & 1) != 0));
+        CHECK(key.constant_time() == ((mode & 2) != 0));
+        // Plus d'appels que de facteurs en réserve : la recharge est exercée
+        for (int i = 0; i < 20; ++i) CHECK(key.pow(x) == ref);
+        mpz_class r;
+        key.pow(r, x, true);
+        CHECK(r == ref);
+
+        string m;
+        mpz_class c;
+        enc(c, "aveuglement", key.public_key());
+        dec_crt(m, c, key);
+        CHECK(m == "aveuglement");
+    }
+
+    // Les copies partagent la réserve, y compris depuis plusieurs threads
+    RsaPrivateKey key = base;
+    key.enable_blinding(4, 777);
+    CHECK(key.blinding_capacity() == 4);
+    vector<thread> users;
+    vector<int> good(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        users.emplace_back([&, t, copy = key] {
+            for (int i = 0; i < 10; ++i) good[t] += copy.pow(x) == ref;
+        });
+    }
+    for (auto& u : users) u.join();
+    for (int g : good) CHECK(g == 10);
+}
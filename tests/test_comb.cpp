@@ -0,0 +1,46 @@
+// Peigne de Lim–Lee (base fixe)
+#include <gmpxx.h>
+#include "lib/comb.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// Peigne de Lim–Lee (base fixe) contre mpz_powm
+// ============================================================
+TEST_GROUP(comb) {
+    gmp_randclass& rng = test_rng();
+    const int shapes[][2] = {{6, 2}, {1, 1}, {4, 1}, {5, 3}, {8, 4}};
+
+    for (unsigned long bits : {256ul, 1024ul, 2048ul}) {
+        mpz_class n = rng.get_z_bits(bits) | 1;
+        mpz_setbit(n.get_mpz_t(), bits - 1);
+        mpz_class g = rng.get_z_range(n);
+
+        for (const auto& hv : shapes) {
+            // max_bits non multiple de h ni de v : lignes et blocs incomplets
+            unsigned long max_bits = bits - 3;
+            FixedBaseComb comb(n, g, max_bits, hv[0], hv[1]);
+
+            for (int i = 0; i < 6; ++i) {
+                mpz_class e = rng.get_z_bits(1 + mpz_class(rng.get_z_range(max_bits)).get_ui());
+                CHECK(comb.exp(e) == powm(g, e, n));
+            }
+            mpz_class full = (mpz_class(1) << max_bits) - 1;      // tous les bits
+            CHECK(comb.exp(full) == powm(g, full, n));
+            CHECK(comb.exp(0) == 1);
+            CHECK(comb.exp(1) == g);
+            // Au-delà de max_bits : repli sur la fenêtre glissante
+            mpz_class longer = rng.get_z_bits(max_bits + 40);
+            mpz_setbit(longer.get_mpz_t(), max_bits + 39);
+            CHECK(comb.exp(longer) == powm(g, longer, n));
+        }
+
+        // Base hors de [0, n) et base nulle
+        FixedBaseComb big(n, g + 5 * n, bits);
+        mpz_class e = rng.get_z_bits(bits);
+        CHECK(big.exp(e) == powm(g, e, n));
+        FixedBaseComb zero(n, 0, bits);
+        CHECK(zero.exp(e) == 0);
+    }
+}
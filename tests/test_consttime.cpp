@@ -0,0 +1,70 @@
+// Fenêtre adaptative et exponentiation à temps constant
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/crt_context.h"
+#include "lib/montgomery.h"
+#include "lib/window.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// Exposant relu depuis le plan : chaque étape décale puis ajoute l'impair
+static mpz_class plan_value(const ExpPlan& plan) {
+    mpz_class e = 0;
+    for (const WindowStep& st : plan.steps) {
+        e <<= st.squarings;
+        if (st.index >= 0) e += 2 * st.index + 1;
+    }
+    return e;
+}
+
+TEST_GROUP(consttime) {
+    gmp_randclass& rng = test_rng();
+
+    // Largeur croissante avec la taille de l'exposant, plafonnée
+    int prev = 1;
+    for (unsigned long b = 0; b <= 4096; ++b) {
+        int w = window_bits(b);
+        CHECK(w >= prev && w <= WINDOW_MAX);
+        prev = w;
+    }
+    CHECK(window_bits(4096) == WINDOW_MAX);
+
+    for (unsigned long bits : {17ul, 64ul, 200ul, 512ul, 1024ul, 2048ul}) {
+        mpz_class e = rng.get_z_bits(bits);
+        ExpPlan plan = window_plan(e);
+        CHECK(plan.w == window_bits(exp_bit_length(e)));
+        CHECK(plan_value(plan) == e);
+    }
+    CHECK(window_plan(0).steps.empty());
+
+    // Temps constant contre mpz_powm : module libre puis Montgomery
+    for (unsigned long bits : {64ul, 512ul, 1024ul, 2048ul}) {
+        mpz_class n = rng.get_z_bits(bits) | 1;
+        mpz_setbit(n.get_mpz_t(), bits - 1);
+        MontgomeryContext mc(n);
+        for (int i = 0; i < 4; ++i) {
+            mpz_class a = rng.get_z_range(n), e = rng.get_z_bits(i == 0 ? 7 : bits);
+            CHECK(mod_exp_consttime(a, e, n) == powm(a, e, n));
+            CHECK(mod_exp_window(a, e, n) == powm(a, e, n));
+            CHECK(mc.exp_consttime(a, e) == powm(a, e, n));
+        }
+        mpz_class a = rng.get_z_range(n);
+        CHECK(mod_exp_consttime(a, 0, n) == 1);
+        CHECK(mod_exp_consttime(a, 1, n) == a);
+        CHECK(mod_exp_consttime(0, 5, n) == 0);
+        CHECK(mod_exp_consttime(a + n, 3, n) == powm(a, 3, n));
+        CHECK(mc.exp_consttime(a, 0) == 1);
+        CHECK(mc.exp_consttime(n - 1, 2) == 1);
+    }
+
+    // Moitiés CRT à temps constant : même résultat que la fenêtre glissante
+    const RsaPrivateKey& key = test_key();
+    CrtContext crt(key.p(), key.q(), key.qinv());
+    for (bool parallel : {false, true}) {
+        mpz_class x = rng.get_z_range(key.n()), r = x;
+        crt.pow_consttime(r, r, key.dp(), key.dq(), parallel);
+        CHECK(r == powm(x, key.d(), key.n()));
+        CHECK(r == crt.pow(x, key.dp(), key.dq()));
+    }
+}
@@ -0,0 +1,65 @@
+// Conversions octets / chaîne <-> entier contre mpz_import / mpz_export
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(convert) {
+    gmp_randclass& rng = test_rng();
+
+    // Toutes les longueurs autour des mots de 64 bits, octet de tête non nul
+    for (size_t len = 0; len <= 41; ++len) {
+        vector<std::byte> in(len);
+        for (size_t i = 0; i < len; ++i) {
+            in[i] = std::byte(mpz_class(rng.get_z_bits(8)).get_ui());
+        }
+        if (len > 0 && in[0] == std::byte(0)) in[0] = std::byte(0x80);
+
+        mpz_class num, ref;
+        bytesToNum(num, in.data(), len);
+        mpz_import(ref.get_mpz_t(), len, 1, 1, 1, 0, in.data());
+        CHECK(num == ref);
+
+        vector<std::byte> out(len + 3, std::byte(0xAA));
+        CHECK(numToBytes(nullptr, 0, num) == len);
+        CHECK(numToBytes(out.data(), out.size(), num) == len);
+        CHECK(equal(in.begin(), in.end(), out.begin()));
+        CHECK(out[len] == std::byte(0xAA));
+
+        // Trop petit : rien n'est écrit, la taille utile est retournée
+        if (len > 0) {
+            out.assign(len + 3, std::byte(0xAA));
+            CHECK(numToBytes(out.data(), len - 1, num) == len);
+            CHECK(out[0] == std::byte(0xAA));
+        }
+
+        // Largeur fixe : zéros à gauche, refus si num ne tient pas
+        out.assign(len + 3, std::byte(0xAA));
+        CHECK(numToBytesFixed(out.data(), len + 3, num));
+        CHECK(out[0] == std::byte(0) && out[1] == std::byte(0) && out[2] == std::byte(0));
+        CHECK(equal(in.begin(), in.end(), out.begin() + 3));
+        if (len > 0) CHECK(!numToBytesFixed(out.data(), len - 1, num));
+
+        // Chaînes : aller-retour, octets nuls internes compris
+        string s(reinterpret_cast<const char*>(in.data()), len), back;
+        stringToNum(num, s);
+        CHECK(num == ref);
+        numToString(back, num);
+        CHECK(back == s);
+    }
+
+    // Zéros de tête : perdus par l'entier, rendus par la largeur fixe
+    string lead("\0\0ab", 4), back;
+    mpz_class num;
+    stringToNum(num, lead);
+    CHECK(num == 0x6162);
+    numToString(back, num);
+    CHECK(back == "ab");
+    numToString(back, 0);
+    CHECK(back.empty());
+}
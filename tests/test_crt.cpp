@@ -0,0 +1,37 @@
+// CRT : moitiés séquentielles et parallèles, fonctions libres et clé
+#include <string>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(crt) {
+    const string msg = "CRT, deux moitiés";
+    for (bool parallel : {false, true}) {
+        mpz_class n, e, d, p, q, phi, dp, dq, qinv;
+        keyGen_crt(1024, test_rng(), n, e, d, p, q, phi, dp, dq, qinv);
+        mpz_class c, s;
+        string m;
+        enc(c, msg, e, n);
+        dec_crt(m, c, p, q, dp, dq, qinv, parallel);
+        CHECK(m == msg);
+        sing_crt(s, msg, p, q, dp, dq, qinv, parallel);
+        CHECK(verify(s, msg, e, n));
+
+        const RsaPrivateKey& key = test_key();
+        enc(c, msg, key.public_key());
+        dec_crt(m, c, key, parallel);
+        CHECK(m == msg);
+        sing_crt(s, msg, key, parallel);
+        CHECK(verify(s, msg, key.public_key()));
+
+        // Même résultat que l'exponentiation directe par d
+        mpz_class x = test_rng().get_z_range(key.n()), r;
+        key.pow(r, x, parallel);
+        CHECK(r == powm(x, key.d(), key.n()));
+    }
+}
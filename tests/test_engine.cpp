@@ -0,0 +1,80 @@
+// RsaEngine : moteur multi-thread, résultats comparés à RsaPrivateKey::pow
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa_engine.h"
+#include "lib/rsa_key.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(engine) {
+    const RsaPrivateKey& key = test_key();
+    gmp_randclass& rng = test_rng();
+
+    // Entrées préparées d'avance : les threads soumetteurs ne touchent
+    // pas au flux aléatoire partagé
+    const unsigned SUBMITTERS = 4, JOBS = 24;
+    vector<mpz_class> cts(SUBMITTERS * JOBS);
+    vector<string> msgs(SUBMITTERS * JOBS);
+    for (size_t i = 0; i < cts.size(); ++i) {
+        cts[i] = rng.get_z_range(key.n());
+        msgs[i] = "message " + to_string(i);
+    }
+
+    // Déchiffrements et signatures mêlés, soumis depuis plusieurs threads
+    {
+        RsaEngine engine(key, 3, 17);
+        CHECK(engine.threads() == 3);
+        vector<future<string>> decs(cts.size());
+        vector<future<mpz_class>> sigs(cts.size());
+        vector<thread> submitters;
+        for (unsigned t = 0; t < SUBMITTERS; ++t) {
+            submitters.emplace_back([&, t] {
+                for (unsigned j = 0; j < JOBS; ++j) {
+                    size_t i = t * JOBS + j;
+                    if (j % 2) decs[i] = engine.decrypt(cts[i]);
+                    else sigs[i] = engine.sign(msgs[i]);
+                }
+            });
+        }
+        for (auto& s : submitters) s.join();
+
+        for (size_t i = 0; i < cts.size(); ++i) {
+            if ((i % JOBS) % 2) {
+                string ref;
+                numToString(ref, key.pow(cts[i]));
+                CHECK(decs[i].get() == ref);
+            } else {
+                mpz_class m;
+                stringToNum(m, msgs[i]);
+                mpz_class s = sigs[i].get();
+                CHECK(s == key.pow(m));
+                CHECK(engine.verify(s, msgs[i]).get());
+                CHECK(!engine.verify(s + 1, msgs[i]).get());
+            }
+        }
+        mpz_class c = engine.encrypt(msgs[0]).get();
+        CHECK(engine.decrypt(c).get() == msgs[0]);
+    }
+
+    // Arrêt avec du travail en file : le destructeur vide les files
+    // avant de rendre la main, aucune promesse n'est abandonnée
+    vector<future<mpz_class>> pending;
+    {
+        RsaEngine engine(key, 2, 23);
+        for (size_t i = 0; i < cts.size(); ++i) {
+            pending.push_back(engine.sign(msgs[i]));
+        }
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        CHECK(pending[i].wait_for(chrono::seconds(0)) == future_status::ready);
+        mpz_class m;
+        stringToNum(m, msgs[i]);
+        CHECK(pending[i].get() == key.pow(m));
+    }
+}
@@ -0,0 +1,127 @@
+// MontLanes, vérification par lot et multi-exponentiation (Shamir / Straus)
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/montgomery.h"
+#include "lib/mont_lanes.h"
+#include "lib/rsa_batch.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// Montgomery sur voies : chaque noyau accepté par select_kernel
+// ============================================================
+TEST_GROUP(lanes) {
+    string detected = MontLanes::kernel();
+    gmp_randclass& rng = test_rng();
+
+    for (unsigned long bits : {256ul, 1024ul, 2048ul}) {
+        vector<LaneModulus> lm;
+        vector<mpz_class> mods;
+        for (size_t l = 0; l < MontLanes::LANES; ++l) {
+            mpz_class n = rng.get_z_bits(bits) | 1;
+            mpz_setbit(n.get_mpz_t(), bits - 1);
+            mods.push_back(n);
+        }
+        for (const auto& n : mods) lm.emplace_back(n);
+        vector<const LaneModulus*> ptrs;
+        for (const auto& m : lm) ptrs.push_back(&m);
+
+        vector<mpz_class> bases, same, mixed;
+        mpz_class e = rng.get_z_bits(bits);
+        for (size_t l = 0; l < MontLanes::LANES; ++l) {
+            bases.push_back(rng.get_z_range(mods[l]));
+            same.push_back(e);
+            mixed.push_back(rng.get_z_bits(bits - 7 * l));
+        }
+        mixed[3] = 0;
+
+        for (const char* kernel : {"avx512ifma", "avx2", "portable"}) {
+            if (!MontLanes::select_kernel(kernel)) continue;
+            MontLanes lanes(ptrs);
+            vector<mpz_class> r;
+            lanes.exp(r, bases, same);
+            for (size_t l = 0; l < MontLanes::LANES; ++l) CHECK(r[l] == powm(bases[l], e, mods[l]));
+            lanes.exp(r, bases, mixed);
+            for (size_t l = 0; l < MontLanes::LANES; ++l) {
+                CHECK(r[l] == powm(bases[l], mixed[l], mods[l]));
+            }
+
+            // Moins de modules que de voies
+            MontLanes three({ptrs[0], ptrs[1], ptrs[2]});
+            vector<mpz_class> b3(bases.begin(), bases.begin() + 3), e3(same.begin(), same.begin() + 3);
+            three.exp(r, b3, e3);
+            CHECK(r.size() == 3);
+            for (size_t l = 0; l < 3 && l < r.size(); ++l) CHECK(r[l] == powm(bases[l], e, mods[l]));
+        }
+    }
+    CHECK(!MontLanes::select_kernel("inconnu"));
+    MontLanes::select_kernel(detected.c_str());
+}
+
+// ============================================================
+// Vérification par lot (voies de MontLanes)
+// ============================================================
+TEST_GROUP(verify_batch) {
+    const RsaPrivateKey& key = test_key();
+    // Vérification par lot : plusieurs clés, au-delà d'un paquet de voies
+    RsaPrivateKey other = keyGen_crt(1024, test_rng());
+    vector<mpz_class> sigs;
+    vector<string> vm;
+    vector<const RsaPublicKey*> keys;
+    for (int i = 0; i < 11; ++i) {
+        const RsaPrivateKey& k = (i % 3) ? key : other;
+        string m = "signé " + to_string(i);
+        mpz_class s;
+        sing_crt(s, m, k);
+        sigs.push_back(s);
+        vm.push_back(m);
+        keys.push_back(&k.public_key());
+    }
+    sigs[2] += 1;                            // mauvaise signature
+    sigs[5] = keys[5]->n() + sigs[5];        // hors de [0, n)
+    sigs[7] = -1;                            // négative
+    vector<bool> ok;
+    verify_batch(ok, sigs, vm, keys);
+    CHECK(ok.size() == sigs.size());
+    for (size_t i = 0; i < ok.size(); ++i) CHECK(ok[i] == (i != 2 && i != 5 && i != 7));
+
+    CHECK_THROWS(verify_batch(ok, sigs, vector<string>(1), keys), invalid_argument);
+}
+
+// ============================================================
+// Multi-exponentiation : une chaîne de carrés pour 1 à 4 bases
+// ============================================================
+TEST_GROUP(multi_exp) {
+    gmp_randclass& rng = test_rng();
+    for (unsigned long bits : {64ul, 512ul, 1024ul}) {
+        mpz_class n = rng.get_z_bits(bits) | 1;
+        mpz_setbit(n.get_mpz_t(), bits - 1);
+        MontgomeryContext mc(n);
+        for (size_t k = 1; k <= 4; ++k) {
+            vector<mpz_class> bases, exps;
+            mpz_class ref = 1;
+            for (size_t i = 0; i < k; ++i) {
+                // Exposants de longueurs différentes, dont un nul
+                mpz_class b = rng.get_z_range(n);
+                mpz_class e = (i == 1) ? mpz_class(0) : mpz_class(rng.get_z_bits(bits / (i + 1)));
+                bases.push_back(b);
+                exps.push_back(e);
+                ref = ref * powm(b, e, n) % n;
+            }
+            CHECK(mc.multi_exp(bases, exps) == ref);
+            CHECK(mod_multi_exp(bases, exps, n) == ref);
+        }
+        // Base hors de [0, n) et base nulle
+        mpz_class a = rng.get_z_range(n), e = rng.get_z_bits(bits);
+        CHECK(mod_multi_exp({a + n, 0}, {e, 5}, n) == 0);
+        CHECK(mod_multi_exp({a + n, a}, {e, 1}, n) == powm(a, e + 1, n));
+    }
+    CHECK_THROWS(mod_multi_exp({2, 3}, {1}, 101), runtime_error);
+    CHECK_THROWS(mod_multi_exp({2}, {-1}, 101), runtime_error);
+}
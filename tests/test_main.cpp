@@ -0,0 +1,33 @@
+// Tests de non-régression de la bibliothèque.
+//
+//   test_rsa [GROUPE]      (sans argument : tous les groupes)
+//
+// Chaque groupe est un add_test de CMakeLists.txt (ctest --test-dir build).
+// Code de sortie : 0 si toutes les vérifications passent, 1 sinon.
+#include <cstdio>
+#include <cstring>
+#include "tests/check.h"
+
+using namespace std;
+
+vector<TestGroup>& test_groups() {
+    static vector<TestGroup> groups;
+    return groups;
+}
+
+int main(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    bool found = false;
+    for (const TestGroup& g : test_groups()) {
+        if (only && strcmp(only, g.name) != 0) continue;
+        found = true;
+        int before = g_failures;
+        g.run();
+        printf("%-12s %s\n", g.name, g_failures == before ? "ok" : "ÉCHEC");
+    }
+    if (!found) {
+        fprintf(stderr, "groupe inconnu : %s\n", only ? only : "(aucun groupe)");
+        return 2;
+    }
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+// Contexte de Montgomery et exponentiations de base.h qui l'utilisent
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/montgomery.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(montgomery) {
+    gmp_randclass& rng = test_rng();
+
+    // Modules d'un mot, juste sous 2^64k et juste au-dessus (R change)
+    vector<mpz_class> mods = {mpz_class(3), mpz_class(1000003)};
+    for (unsigned long bits : {63ul, 64ul, 65ul, 512ul, 1024ul, 2047ul}) {
+        mpz_class n = rng.get_z_bits(bits) | 1;
+        mpz_setbit(n.get_mpz_t(), bits - 1);
+        mods.push_back(n);
+    }
+    mods.push_back((mpz_class(1) << 128) - 1);
+
+    for (const mpz_class& n : mods) {
+        MontgomeryContext mc(n);
+        mpz_class R = mpz_class(1) << mc.bits();
+        CHECK(mc.bits() % 64 == 0);
+        CHECK(R > n);
+        CHECK(mc.one() == R % n);
+
+        for (int i = 0; i < 10; ++i) {
+            mpz_class a = rng.get_z_range(n), b = rng.get_z_range(n);
+            mpz_class e = rng.get_z_bits(mpz_sizeinbase(n.get_mpz_t(), 2) + 3);
+            mpz_class am = mc.to_mont(a), bm = mc.to_mont(b);
+            CHECK(am == a * R % n);
+            CHECK(mc.from_mont(mc.mul(am, bm)) == a * b % n);
+            CHECK(mc.exp(a, e) == powm(a, e, n));
+            CHECK(mc.exp(a, window_plan(e)) == powm(a, e, n));
+            CHECK(mc.exp_65537(a) == powm(a, 65537, n));
+            CHECK(mc.multi_exp({a, b}, {e, e + 1}) == powm(a, e, n) * powm(b, e + 1, n) % n);
+
+            // Entrée pour des bases hors de [0, n) : au-delà de n*R, négatives
+            mpz_class big = a + n * R * (i + 1);
+            CHECK(mc.enter(big) == am);
+            CHECK(mc.enter(a - n * (i + 1)) == am);
+            CHECK(mc.to_mont_reduce(a + n * rng.get_z_range(R)) == am);
+
+            // En place : r est une des entrées
+            mpz_class r = am;
+            mc.mul(r, r, bm);
+            CHECK(r == mc.mul(am, bm));
+            mpz_class x = a;
+            mc.exp_mont(x, x, window_plan(e));
+            CHECK(mc.from_mont(x) == powm(a, e, n));
+        }
+        CHECK(mc.exp(0, 5) == 0);
+        CHECK(mc.exp(7, 0) == 1 % n);
+    }
+
+    // Exponentiations de base.h
+    for (int i = 0; i < 10; ++i) {
+        mpz_class n = rng.get_z_bits(256 + 64 * i) | 1;
+        mpz_class a = rng.get_z_range(n), e = rng.get_z_bits(300);
+        CHECK(ExpoMod(a, e, n) == powm(a, e, n));
+        CHECK(mod_exp_window(a, e, n) == powm(a, e, n));
+        CHECK(mod_exp_65537(a, n) == powm(a, 65537, n));
+        CHECK(mod_multi_exp({a, a + 1}, {e, 3}, n) == powm(a, e, n) * powm(a + 1, 3, n) % n);
+    }
+}
@@ -0,0 +1,88 @@
+// Noyau Karatsuba / Toom-3 de bench/mul.h (banc d'essai, hors bibliothèque)
+#include <cstdint>
+#include <vector>
+#include <gmp.h>
+#include <gmpxx.h>
+#include "bench/mul.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// Noyau de multiplication (bench/mul.h) contre mpn_mul / mpn_sqr de GMP
+// ============================================================
+static void random_limbs(vector<uint64_t>& v, size_t n, int pattern, gmp_randclass& rng) {
+    v.assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        if (pattern == 0) v[i] = mpz_class(rng.get_z_bits(64)).get_ui();
+        else if (pattern == 1) v[i] = ~uint64_t(0);             // retenues maximales
+        else v[i] = (i % 3 == 0) ? ~uint64_t(0) : 0;            // mots nuls intercalés
+    }
+}
+
+TEST_GROUP(mul) {
+    gmp_randclass& rng = test_rng();
+    vector<uint64_t> a, b, r, ref, scratch;
+
+    // Tous les n jusqu'au-delà des seuils de Toom-3, puis quelques
+    // tailles où Toom-3 se rappelle lui-même
+    vector<size_t> sizes;
+    for (size_t n = 1; n <= SQR_TOOM3_THRESHOLD + 40; ++n) sizes.push_back(n);
+    for (size_t n : {255, 256, 257, 384, 401, 512}) sizes.push_back(n);
+
+    for (size_t n : sizes) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            random_limbs(a, n, pattern, rng);
+            random_limbs(b, n, pattern == 2 ? 1 : pattern, rng);
+            r.assign(2 * n, 0);
+            ref.assign(2 * n, 0);
+
+            mpn_mul_n(ref.data(), a.data(), b.data(), n);
+            limb_mul(r.data(), a.data(), b.data(), n);
+            CHECK(r == ref);
+
+            mpn_sqr(ref.data(), a.data(), n);
+            limb_sqr(r.data(), a.data(), n);
+            CHECK(r == ref);
+        }
+    }
+
+    // Un seul niveau de chaque algorithme, de part et d'autre des seuils
+    for (size_t n : {2, 3, 5, 6, 7, 23, 24, 25, 47, 48, 49, 127, 128, 129, 159, 160, 161}) {
+        random_limbs(a, n, 0, rng);
+        random_limbs(b, n, 0, rng);
+        r.assign(2 * n, 0);
+        ref.assign(2 * n, 0);
+        scratch.assign(limb_mul_scratch(n), 0);
+
+        mpn_mul_n(ref.data(), a.data(), b.data(), n);
+        limb_mul_karatsuba(r.data(), a.data(), b.data(), n, scratch.data());
+        CHECK(r == ref);
+        if (n >= 5) {
+            limb_mul_toom3(r.data(), a.data(), b.data(), n, scratch.data());
+            CHECK(r == ref);
+        }
+
+        mpn_sqr(ref.data(), a.data(), n);
+        limb_sqr_karatsuba(r.data(), a.data(), n, scratch.data());
+        CHECK(r == ref);
+        if (n >= 5) {
+            limb_sqr_toom3(r.data(), a.data(), n, scratch.data());
+            CHECK(r == ref);
+        }
+    }
+
+    // Cas de base à opérandes de tailles différentes
+    for (size_t an : {1, 7, 30}) {
+        for (size_t bn : {1, 5, 30}) {
+            random_limbs(a, an, 0, rng);
+            random_limbs(b, bn, 0, rng);
+            r.assign(an + bn, 0);
+            ref.assign(an + bn, 0);
+            if (an >= bn) mpn_mul(ref.data(), a.data(), an, b.data(), bn);
+            else mpn_mul(ref.data(), b.data(), bn, a.data(), an);
+            limb_mul_basecase(r.data(), a.data(), an, b.data(), bn);
+            CHECK(r == ref);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+// RSA à plusieurs facteurs : clés, CRT multi-premiers, temps constant
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa.h"
+#include "lib/rsa_key.h"
+#include "lib/rsa_mp.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// RSA à plusieurs facteurs, k = 2..4
+// ============================================================
+TEST_GROUP(multi_prime) {
+    const string msg = "multi-premiers";
+    for (unsigned k = 2; k <= 4; ++k) {
+        RsaMultiPrimeKey key = keyGen_mp(1536, k, test_rng());
+        CHECK(key.count() == k);
+        mpz_class prod = 1;
+        for (const auto& r : key.primes()) prod *= r;
+        CHECK(prod == key.n());
+
+        for (bool parallel : {false, true}) {
+            mpz_class c, s;
+            string m;
+            enc(c, msg, key.public_key());
+            dec_mp(m, c, key, parallel);
+            CHECK(m == msg);
+            sing_mp(s, msg, key, parallel);
+            CHECK(verify(s, msg, key.public_key()));
+            dec_mp(m, c, key.primes(), key.exponents(), key.coefficients(), parallel);
+            CHECK(m == msg);
+        }
+
+        RsaMultiPrimeKey ct = key;
+        ct.set_constant_time(true);
+        mpz_class x = test_rng().get_z_range(key.n()), r;
+        CHECK(ct.pow(x) == powm(x, key.d(), key.n()));
+        key.pow(r, x, true);
+        CHECK(r == powm(x, key.d(), key.n()));
+    }
+
+    // Paramètres refusés : nombre de facteurs, facteurs trop petits,
+    // facteurs incohérents avec n
+    CHECK_THROWS(keyGen_mp(1536, 5, test_rng()), runtime_error);
+    CHECK_THROWS(keyGen_mp(1536, 1, test_rng()), runtime_error);
+    CHECK_THROWS(keyGen_mp(160, 3, test_rng()), runtime_error);
+    RsaMultiPrimeKey key = keyGen_mp(1536, 3, test_rng());
+    vector<mpz_class> primes = key.primes();
+    CHECK_THROWS(RsaMultiPrimeKey(key.n(), key.e(), key.d(), {primes[0]}), runtime_error);
+    primes[2] = primes[1];
+    CHECK_THROWS(RsaMultiPrimeKey(key.n(), key.e(), key.d(), primes), runtime_error);
+    primes.pop_back();
+    CHECK_THROWS(RsaMultiPrimeKey(key.n(), key.e(), key.d(), primes), runtime_error);
+}
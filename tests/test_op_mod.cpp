@@ -0,0 +1,134 @@
+// op_mod : PGCD de Lehmer, Euclide étendu, inverses modulaires (un à un et par lot)
+#include <stdexcept>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/op_mod.h"
+#include "lib/prime_lib.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// extended_gcd / lehmer_gcd contre mpz_gcd / mpz_gcdext
+// ============================================================
+static void check_gcd(const mpz_class& A, const mpz_class& B) {
+    mpz_class ref;
+    mpz_gcd(ref.get_mpz_t(), A.get_mpz_t(), B.get_mpz_t());
+    CHECK(lehmer_gcd(A, B) == ref);
+    CHECK(op_pgcd(A, B) == ref);
+
+    auto [g, x, y] = extended_gcd(A, B);
+    CHECK(g == ref);
+    CHECK(A * x + B * y == g);
+}
+
+TEST_GROUP(gcd) {
+    gmp_randclass& rng = test_rng();
+
+    // Zéros, unités, A < B, A = B
+    for (long a : {0l, 1l, 2l, 12l}) {
+        for (long b : {0l, 1l, 18l, 97l}) check_gcd(a, b);
+    }
+    check_gcd(5, 5);
+
+    // Tailles de un mot à plusieurs milliers de bits (les pas de Lehmer
+    // ne servent qu'au-delà d'un mot), dans les deux ordres et avec tous
+    // les signes
+    for (unsigned long bits : {30ul, 64ul, 65ul, 200ul, 1024ul, 3000ul}) {
+        for (int i = 0; i < 4; ++i) {
+            mpz_class a = rng.get_z_bits(bits), b = rng.get_z_bits(bits / 2 + 1);
+            // Grand facteur commun : pgcd non trivial
+            if (i % 2) {
+                mpz_class f = rng.get_z_bits(bits / 3 + 1) + 1;
+                a *= f;
+                b *= f;
+            }
+            for (int sa : {1, -1}) {
+                for (int sb : {1, -1}) {
+                    check_gcd(sa * a, sb * b);
+                    check_gcd(sb * b, sa * a);
+                }
+            }
+            check_gcd(a, 0);
+            check_gcd(0, -b);
+        }
+    }
+
+    // Fibonacci consécutifs : le plus long déroulé d'Euclide
+    mpz_class f0 = 0, f1 = 1;
+    for (int i = 0; i < 3000; ++i) {
+        mpz_class t = f0 + f1;
+        f0 = f1;
+        f1 = t;
+    }
+    check_gcd(f1, f0);
+
+    // invmod contre mpz_invert, et l'absence d'inverse
+    mpz_class n = rng.get_z_bits(1024) | 1;
+    for (int i = 0; i < 8; ++i) {
+        mpz_class a = rng.get_z_range(n), ref;
+        if (mpz_invert(ref.get_mpz_t(), a.get_mpz_t(), n.get_mpz_t())) {
+            CHECK(invmod(a, n) == ref);
+            CHECK(invmod(a + n, n) == ref);
+        }
+    }
+    CHECK_THROWS(invmod(0, n), runtime_error);
+    CHECK_THROWS(invmod(6, 9), runtime_error);
+}
+
+// ============================================================
+// invmod_batch : astuce de Montgomery, indice du premier non inversible
+// ============================================================
+TEST_GROUP(invmod_batch) {
+    gmp_randclass& rng = test_rng();
+    mpz_class p = genAlea(rng, 256), q = genAlea(rng, 256);
+    mpz_class n = p * q;
+
+    auto random_units = [&](size_t k) {
+        vector<mpz_class> A(k);
+        for (auto& a : A) {
+            do a = rng.get_z_range(n); while (op_pgcd(a, n) != 1);
+        }
+        return A;
+    };
+
+    // Tout inversible, k = 1 compris ; éléments hors de [0, n) acceptés
+    for (size_t k : {1u, 2u, 7u, 64u}) {
+        vector<mpz_class> A = random_units(k), inv;
+        if (k > 1) A[1] += 3 * n;
+        CHECK(invmod_batch(inv, A, n) == -1);
+        CHECK(inv.size() == k);
+        for (size_t i = 0; i < k; ++i) CHECK(inv[i] == invmod(A[i], n));
+    }
+
+    // Lot vide : rien à inverser
+    vector<mpz_class> inv(3, 1);
+    CHECK(invmod_batch(inv, {}, n) == -1);
+    CHECK(inv.empty());
+
+    // Un zéro, un multiple de p, un multiple de n : l'indice du premier
+    // coupable est retourné et inv est vide, qu'il soit en tête, au
+    // milieu ou en queue
+    const size_t k = 9;
+    vector<mpz_class> culprits = {0, p * 5, n, q};
+    for (const mpz_class& bad : culprits) {
+        for (size_t at : {size_t(0), k / 2, k - 1}) {
+            vector<mpz_class> A = random_units(k);
+            A[at] = bad;
+            inv.assign(2, 1);
+            CHECK(invmod_batch(inv, A, n) == (long)at);
+            CHECK(inv.empty());
+
+            // Deux coupables : le premier l'emporte
+            if (at + 1 < k) {
+                A[k - 1] = p;
+                CHECK(invmod_batch(inv, A, n) == (long)at);
+                CHECK(inv.empty());
+            }
+        }
+    }
+
+    // k = 1 non inversible
+    CHECK(invmod_batch(inv, {p}, n) == 0);
+    CHECK(inv.empty());
+}
@@ -0,0 +1,89 @@
+// Primalité : Miller-Rabin, BPSW, nombre de tours
+#include <stdexcept>
+#include <gmpxx.h>
+#include "lib/montgomery.h"
+#include "lib/prime_lib.h"
+#include "lib/window.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// Primalité : pseudopremiers forts, BPSW
+// ============================================================
+TEST_GROUP(primality) {
+    PrimalityConfig mr, bpsw;
+    bpsw.mode = PrimalityMode::BailliePSW;
+
+    // Pseudopremiers forts pour les bases 2, 3, 5, 7 (3215031751), 2 à 23
+    // (3825123056546413051) et 2 à 37 (psi_12, 79 bits : seul le test de
+    // Lucas de BPSW le rejette après la base 2)
+    for (const char* str : {"3215031751", "3825123056546413051", "318665857834031151167461"}) {
+        mpz_class n(str);
+        CHECK(!primTest(n, mr));
+        CHECK(!primTest(n, bpsw));
+
+        // ... alors que chacune de ces bases, seule, les laisse passer
+        mpz_class d = n - 1;
+        unsigned long s = mpz_scan1(d.get_mpz_t(), 0);
+        d >>= s;
+        MontgomeryContext mc(n);
+        ExpPlan plan = window_plan(d);
+        for (unsigned long a : {2ul, 3ul, 5ul, 7ul}) CHECK(miller_rabin(mc, plan, s, mpz_class(a)));
+    }
+    mpz_class psi12("318665857834031151167461");
+    CHECK(!strong_lucas(MontgomeryContext(psi12)));
+
+    // Nombres de Carmichael et petits cas
+    for (unsigned long n : {561ul, 1105ul, 41041ul, 825265ul, 0ul, 1ul, 4ul, 9ul}) {
+        CHECK(!primTest(mpz_class(n), mr));
+        CHECK(!primTest(mpz_class(n), bpsw));
+    }
+    for (unsigned long n : {2ul, 3ul, 5ul, 10007ul, 2147483647ul}) {
+        CHECK(primTest(mpz_class(n), mr));
+        CHECK(primTest(mpz_class(n), bpsw));
+    }
+
+    // Premiers de Mersenne et leurs voisins composés
+    for (unsigned long k : {89ul, 127ul, 521ul, 607ul}) {
+        mpz_class m = (mpz_class(1) << k) - 1;
+        CHECK(primTest(m, mr));
+        CHECK(primTest(m, bpsw));
+        CHECK(strong_lucas(MontgomeryContext(m)));
+        CHECK(!primTest(m + 2, bpsw));
+    }
+
+    // Accord avec GMP sur des impairs au hasard
+    gmp_randclass& rng = test_rng();
+    for (int i = 0; i < 300; ++i) {
+        mpz_class n = rng.get_z_bits(64 + i) | 1;
+        bool ref = mpz_probab_prime_p(n.get_mpz_t(), 40) != 0;
+        CHECK(primTest(n, mr) == ref);
+        CHECK(primTest(n, bpsw) == ref);
+    }
+
+    mpz_class p = genAlea(rng, 512, nullptr, bpsw);
+    CHECK(mpz_sizeinbase(p.get_mpz_t(), 2) == 512);
+    CHECK(mpz_probab_prime_p(p.get_mpz_t(), 40) != 0);
+
+    // Nombre de tours : moins de tours quand n grandit, plus quand
+    // l'erreur visée baisse ; erreur par défaut selon la taille RSA
+    for (unsigned long bits = 64; bits <= 4096; bits *= 2) {
+        CHECK(mr_rounds(2 * bits, 100) <= mr_rounds(bits, 100));
+        CHECK(mr_rounds(bits, 100) <= mr_rounds(bits, 128));
+        CHECK(mr_rounds(bits, 100) >= 1);
+    }
+    CHECK(mr_rounds(1024, 100) <= 5);
+    CHECK_THROWS(mr_rounds(20, 100), invalid_argument);
+    CHECK(fips_error_bits(512) == 100);
+    CHECK(fips_error_bits(1024) == 112);
+    CHECK(fips_error_bits(2048) == 128);
+
+    // Nombre de tours imposé : un premier passe toujours ; sous 2^64 le
+    // test reste déterministe quel que soit ce nombre
+    PrimalityConfig fixed;
+    fixed.rounds = 1;
+    CHECK(primTest(p, fixed, rng));
+    CHECK(!primTest(mpz_class("3825123056546413051"), fixed, rng));
+    CHECK(primTest(mpz_class(2147483647), fixed, rng));
+}
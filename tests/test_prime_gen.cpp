@@ -0,0 +1,28 @@
+// Génération de premiers : recherche par crible, paire parallèle
+#include <atomic>
+#include <gmpxx.h>
+#include "lib/prime_lib.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(prime_gen) {
+    gmp_randclass& rng = test_rng();
+    for (unsigned long bits : {64ul, 256ul, 512ul}) {
+        mpz_class x = genAlea(rng, bits);
+        CHECK(mpz_sizeinbase(x.get_mpz_t(), 2) == bits);
+        CHECK(mpz_probab_prime_p(x.get_mpz_t(), 30) != 0);
+
+        mpz_class p, q;
+        genAleaPair(rng, bits, p, q);
+        CHECK(p != q);
+        CHECK(mpz_sizeinbase(p.get_mpz_t(), 2) == bits);
+        CHECK(mpz_sizeinbase(q.get_mpz_t(), 2) == bits);
+        CHECK(mpz_probab_prime_p(p.get_mpz_t(), 30) != 0);
+        CHECK(mpz_probab_prime_p(q.get_mpz_t(), 30) != 0);
+    }
+
+    // Recherche annulée avant de commencer : 0
+    atomic<bool> stop(true);
+    CHECK(genAlea(rng, 256, &stop) == 0);
+}
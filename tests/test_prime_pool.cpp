@@ -0,0 +1,88 @@
+// PrimePool : remplissage, file vidée, statistiques, keyGen_crt sur la réserve
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/prime_pool.h"
+#include "lib/rsa.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// Attend que toutes les files soient pleines (20 s au plus)
+static bool wait_full(const PrimePool& pool) {
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(20);
+    while (chrono::steady_clock::now() < deadline) {
+        bool full = true;
+        for (const auto& st : pool.stats()) full = full && st.depth == st.capacity;
+        if (full) return true;
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    return false;
+}
+
+TEST_GROUP(prime_pool) {
+    gmp_randclass& rng = test_rng();
+    PrimePool pool({256, 512}, 3, 2, 99);
+
+    // Capacité arrondie à une puissance de 2, files remplies en arrière-plan
+    vector<PrimePoolStats> st = pool.stats();
+    CHECK(st.size() == 2);
+    CHECK(st[0].bits == 256 && st[1].bits == 512);
+    CHECK(st[0].capacity == 4 && st[1].capacity == 4);
+    CHECK(wait_full(pool));
+    st = pool.stats();
+    CHECK(st[0].generated >= 4 && st[1].generated >= 4);
+    CHECK(st[0].served == 0 && st[0].misses == 0);
+    CHECK(st[0].mean_gen_ms > 0);
+
+    // Vider la file de 256 bits puis aller au-delà : un seul défaut, les
+    // premiers servis sont distincts et de la bonne taille
+    set<mpz_class> seen;
+    mpz_class p;
+    uint64_t taken = 0;
+    while (taken < 1000 && pool.try_take(256, p)) {
+        ++taken;
+        CHECK(mpz_sizeinbase(p.get_mpz_t(), 2) == 256);
+        CHECK(mpz_probab_prime_p(p.get_mpz_t(), 30) != 0);
+        seen.insert(p);
+    }
+    CHECK(taken >= 4 && taken < 1000);
+    CHECK(seen.size() == taken);
+    st = pool.stats();
+    CHECK(st[0].served == taken);
+    CHECK(st[0].misses == 1);
+    CHECK(st[0].generated >= st[0].served);
+    CHECK(st[1].served == 0 && st[1].misses == 0);
+
+    // Taille non servie : ni premier ni statistique, take() génère
+    CHECK(!pool.try_take(384, p));
+    mpz_class q = pool.take(384, rng);
+    CHECK(mpz_sizeinbase(q.get_mpz_t(), 2) == 384);
+    CHECK(mpz_probab_prime_p(q.get_mpz_t(), 30) != 0);
+    CHECK(pool.stats().size() == 2);
+
+    // keyGen_crt sur la réserve : p et q de 512 bits pris dans la file
+    CHECK(wait_full(pool));
+    RsaPrivateKey key = keyGen_crt(1024, rng, &pool);
+    st = pool.stats();
+    CHECK(st[1].served == 2);
+    CHECK(key.n() == key.p() * key.q());
+    CHECK(key.p() != key.q());
+    CHECK(mpz_sizeinbase(key.p().get_mpz_t(), 2) == 512);
+    mpz_class c, s;
+    string m;
+    enc(c, "réserve", key.public_key());
+    dec_crt(m, c, key);
+    CHECK(m == "réserve");
+    sing_crt(s, "réserve", key);
+    CHECK(verify(s, "réserve", key.public_key()));
+
+    CHECK_THROWS(PrimePool({}, 4, 1, 1), invalid_argument);
+    CHECK_THROWS(PrimePool({1}, 4, 1, 1), invalid_argument);
+}
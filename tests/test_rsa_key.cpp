@@ -0,0 +1,52 @@
+// RSA : fonctions libres et objets clés (RsaPublicKey / RsaPrivateKey)
+#include <string>
+#include <gmpxx.h>
+#include "lib/base.h"
+#include "lib/rsa.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "tests/check.h"
+
+using namespace std;
+
+TEST_GROUP(rsa) {
+    const string msg = "Bonjour RSA";
+    mpz_class n, e, d, p, q, phi;
+    keyGen(1024, test_rng(), n, e, d, p, q, phi);
+    CHECK(n == p * q);
+    CHECK((e * d) % phi == 1);
+
+    mpz_class c, s;
+    string m;
+    enc(c, msg, e, n);
+    dec(m, c, d, n);
+    CHECK(m == msg);
+    sing(s, msg, d, n);
+    CHECK(verify(s, msg, e, n));
+    CHECK(!verify(s + 1, msg, e, n));
+    CHECK(!verify(s, msg + "!", e, n));
+
+    // Même clé sous forme d'objets
+    mpz_class dp = d % (p - 1), dq = d % (q - 1), qinv;
+    mpz_invert(qinv.get_mpz_t(), q.get_mpz_t(), p.get_mpz_t());
+    RsaPrivateKey key(n, e, d, p, q, dp, dq, qinv);
+    enc(c, msg, key.public_key());
+    dec_crt(m, c, key);
+    CHECK(m == msg);
+    sing_crt(s, msg, key);
+    CHECK(verify(s, msg, key.public_key()));
+    CHECK(!verify(s + 1, msg, key.public_key()));
+
+    // Accesseurs, copie, exponentiations publique et privée (en place)
+    CHECK(key.n() == n && key.e() == e && key.d() == d);
+    CHECK(key.p() == p && key.q() == q);
+    CHECK(key.dp() == dp && key.dq() == dq && key.qinv() == qinv);
+    RsaPrivateKey copy = key;
+    mpz_class x = test_rng().get_z_range(n);
+    CHECK(key.public_key().pow(x) == powm(x, e, n));
+    CHECK(copy.public_key().pow(x) == powm(x, e, n));
+    mpz_class r = x;
+    copy.pow(r, r);
+    CHECK(r == powm(x, d, n));
+    CHECK(key.public_key().pow(r) == x);
+}
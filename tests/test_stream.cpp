@@ -0,0 +1,125 @@
+// Flux hybride RSA + ChaCha20-Poly1305 et AEAD sous-jacent
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <gmpxx.h>
+#include "lib/chacha20.h"
+#include "lib/rsa_crt.h"
+#include "lib/rsa_key.h"
+#include "lib/stream.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// ChaCha20-Poly1305 : vecteur de la RFC 8439, §2.8.2
+// ============================================================
+TEST_GROUP(aead) {
+    const char* plain =
+        "Ladies and Gentlemen of the class of '99: If I could offer you only one tip "
+        "for the future, sunscreen would be it.";
+    const uint8_t aad[12] = {0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7};
+    const uint8_t nonce[12] = {0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47};
+    uint8_t key[32];
+    for (int i = 0; i < 32; ++i) key[i] = (uint8_t)(0x80 + i);
+    const uint8_t expected[114] = {
+        0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+        0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe, 0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+        0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+        0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+        0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c, 0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+        0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+        0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+        0x61, 0x16};
+    const uint8_t expected_tag[16] = {0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a,
+                                      0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91};
+
+    vector<byte> in = to_bytes(plain);
+    CHECK(in.size() == sizeof(expected));
+    const byte* k = reinterpret_cast<const byte*>(key);
+    const byte* iv = reinterpret_cast<const byte*>(nonce);
+    const byte* ad = reinterpret_cast<const byte*>(aad);
+
+    vector<byte> ct(in.size()), back(in.size());
+    byte tag[16];
+    aead_seal(ct.data(), tag, k, iv, ad, sizeof(aad), in.data(), in.size());
+    CHECK(memcmp(ct.data(), expected, sizeof(expected)) == 0);
+    CHECK(memcmp(tag, expected_tag, 16) == 0);
+
+    CHECK(aead_open(back.data(), tag, k, iv, ad, sizeof(aad), ct.data(), ct.size()));
+    CHECK(back == in);
+
+    // Étiquette, chiffré ou données associées altérés : refus
+    tag[15] ^= byte(0x80);
+    CHECK(!aead_open(back.data(), tag, k, iv, ad, sizeof(aad), ct.data(), ct.size()));
+    tag[15] ^= byte(0x80);
+    ct[0] ^= byte(0x01);
+    CHECK(!aead_open(back.data(), tag, k, iv, ad, sizeof(aad), ct.data(), ct.size()));
+    ct[0] ^= byte(0x01);
+    CHECK(!aead_open(back.data(), tag, k, iv, ad, sizeof(aad) - 1, ct.data(), ct.size()));
+}
+
+// ============================================================
+// Flux hybride : aller-retour, troncature, altération
+// ============================================================
+static vector<byte> seal_stream(const RsaPublicKey& pub, const vector<byte>& msg) {
+    StreamEncryptor enc(pub);
+    vector<byte> out;
+    // Découpe irrégulière : les segments ne suivent pas les appels
+    size_t pos = 0, step = 1000;
+    while (pos < msg.size()) {
+        size_t len = min(step, msg.size() - pos);
+        enc.update(msg.data() + pos, len, out);
+        pos += len;
+        step = step * 3 + 7;
+    }
+    enc.finalize(out);
+    return out;
+}
+
+static bool open_stream(const RsaPrivateKey& key, const vector<byte>& in, vector<byte>& out) {
+    out.clear();
+    try {
+        StreamDecryptor dec(key);
+        for (size_t pos = 0; pos < in.size(); pos += 4096) {
+            dec.update(in.data() + pos, min<size_t>(4096, in.size() - pos), out);
+        }
+        dec.finalize(out);
+        return true;
+    } catch (const runtime_error&) {
+        return false;
+    }
+}
+
+TEST_GROUP(stream) {
+    const RsaPrivateKey& key = test_key();
+    for (size_t size : {size_t(0), size_t(1), StreamEncryptor::SEGMENT, 3 * StreamEncryptor::SEGMENT + 17}) {
+        vector<byte> msg(size);
+        for (size_t i = 0; i < size; ++i) msg[i] = byte(i * 131 + 7);
+        vector<byte> sealed = seal_stream(key.public_key(), msg), out;
+        CHECK(open_stream(key, sealed, out));
+        CHECK(out == msg);
+
+        // Troncature : dernier octet, dernier segment entier
+        vector<byte> cut(sealed.begin(), sealed.end() - 1);
+        CHECK(!open_stream(key, cut, out));
+        if (size > StreamEncryptor::SEGMENT) {
+            cut.assign(sealed.begin(), sealed.begin() + (sealed.size() - (size % StreamEncryptor::SEGMENT) - 16));
+            CHECK(!open_stream(key, cut, out));
+        }
+
+        // Altération : clé chiffrée, premier segment, étiquette finale
+        for (size_t at : {size_t(10), sealed.size() / 2, sealed.size() - 1}) {
+            vector<byte> bad = sealed;
+            bad[at] ^= byte(0x01);
+            CHECK(!open_stream(key, bad, out));
+        }
+    }
+
+    // Autre clé : la clé de session retombe sur le rejet implicite
+    vector<byte> msg = to_bytes("destinataire");
+    vector<byte> sealed = seal_stream(key.public_key(), msg), out;
+    RsaPrivateKey other = keyGen_crt(1024, test_rng());
+    CHECK(!open_stream(other, sealed, out));
+}
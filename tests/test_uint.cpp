@@ -0,0 +1,109 @@
+// UInt, UIntMontgomery et moitiés CRT de CrtContext sur UInt
+#include <cstdint>
+#include <gmpxx.h>
+#include "lib/crt_context.h"
+#include "lib/prime_lib.h"
+#include "lib/rsa_crt.h"
+#include "lib/uint.h"
+#include "lib/window.h"
+#include "tests/check.h"
+
+using namespace std;
+
+// ============================================================
+// UInt : Montgomery à taille fixe et moitiés CRT de CrtContext
+// ============================================================
+static constexpr UInt<128> uint128(uint64_t lo, uint64_t hi) {
+    UInt<128> r;
+    r.limb[0] = lo;
+    r.limb[1] = hi;
+    return r;
+}
+
+// Chemin constexpr (CIOS, réduction en C) évalué à la compilation
+static constexpr UIntMontgomery<128> CT_CTX(uint128(0x2f0a9e1c3b5d7f61ull, 0xc4e7a2b1f0d39e85ull));
+static constexpr UInt<128> CT_A = uint128(0x0123456789abcdefull, 0x1122334455667788ull);
+static constexpr UInt<128> CT_MUL = CT_CTX.mul(CT_A, CT_CTX.one());
+static constexpr UInt<128> CT_SQR = CT_CTX.sqr(CT_A);
+static constexpr UInt<128> CT_EXP = CT_CTX.exp(CT_A, UInt<64>(65537));
+
+template <size_t B>
+static void check_uint_size(gmp_randclass& rng) {
+    mpz_class n = rng.get_z_bits(B) | 1;
+    mpz_setbit(n.get_mpz_t(), B - 1);
+    UIntMontgomery<B> ctx(uint_from_mpz<B>(n));
+    mpz_class R = mpz_class(1) << B, Rinv;
+    mpz_invert(Rinv.get_mpz_t(), R.get_mpz_t(), n.get_mpz_t());
+
+    for (int i = 0; i < 8; ++i) {
+        mpz_class a = rng.get_z_range(n), b = rng.get_z_range(n);
+        mpz_class e = rng.get_z_bits(i == 0 ? 20 : B);
+        UInt<B> ua = uint_from_mpz<B>(a), ub = uint_from_mpz<B>(b);
+        CHECK(uint_to_mpz(ctx.mul(ua, ub)) == a * b * Rinv % n);
+        CHECK(uint_to_mpz(ctx.sqr(ua)) == a * a * Rinv % n);
+        CHECK(uint_to_mpz(ctx.exp(ua, window_plan(e))) == powm(a, e, n));
+        CHECK(uint_to_mpz(ctx.exp(ua, uint_from_mpz<B>(e))) == powm(a, e, n));
+    }
+    // Bords : n - 1, 0, exposant nul
+    mpz_class m1 = n - 1;
+    CHECK(uint_cmp(ctx.sqr(ctx.to_mont(uint_from_mpz<B>(m1))), ctx.one()) == 0);
+    CHECK(uint_to_mpz(ctx.exp(UInt<B>(0), window_plan(mpz_class(5)))) == 0);
+    CHECK(uint_to_mpz(ctx.exp(uint_from_mpz<B>(m1), window_plan(mpz_class(0)))) == 1);
+}
+
+TEST_GROUP(uint) {
+    gmp_randclass& rng = test_rng();
+
+    // Le chemin d'exécution (mpn) donne les mêmes résultats que le CIOS constexpr
+    UIntMontgomery<128> rt = CT_CTX;
+    CHECK(uint_cmp(rt.mul(CT_A, rt.one()), CT_MUL) == 0);
+    CHECK(uint_cmp(rt.sqr(CT_A), CT_SQR) == 0);
+    CHECK(uint_cmp(rt.exp(CT_A, window_plan(mpz_class(65537))), CT_EXP) == 0);
+    CHECK(uint_to_mpz(CT_EXP) == powm(uint_to_mpz(CT_A), 65537, uint_to_mpz(CT_CTX.modulus())));
+
+    check_uint_size<128>(rng);
+    check_uint_size<512>(rng);
+    check_uint_size<1024>(rng);
+    check_uint_size<1536>(rng);
+    check_uint_size<2048>(rng);
+
+    // Miller–Rabin : 3215031751 passe les bases 2, 3, 5, 7, pas 11
+    UIntMontgomery<64> spsp(UInt<64>(3215031751ull));
+    for (uint64_t a : {2, 3, 5, 7}) CHECK(uint_miller_rabin(spsp, UInt<64>(a)));
+    CHECK(!uint_miller_rabin(spsp, UInt<64>(11)));
+    mpz_class p = genAlea(rng, 512);
+    UIntMontgomery<512> pctx(uint_from_mpz<512>(p));
+    for (uint64_t a : {2, 3, 65537}) CHECK(uint_miller_rabin(pctx, UInt<512>(a)));
+
+    // CrtContext : moitiés sur UInt aux tailles déployées, mpz sinon
+    for (unsigned long bits : {1024ul, 1152ul, 2048ul}) {
+        RsaPrivateKey key = keyGen_crt(bits, rng);
+        CrtContext crt(key.p(), key.q(), key.qinv());
+        CHECK(crt.fixed() == (bits != 1152));
+        CHECK(!(crt.fixed() && crt.lanes()));
+        ExpPlan dp = window_plan(key.dp()), dq = window_plan(key.dq());
+        for (int i = 0; i < 4; ++i) {
+            mpz_class x = rng.get_z_range(key.n()), r;
+            mpz_class ref = powm(x, key.d(), key.n());
+            crt.pow(r, x, dp, dq);
+            CHECK(r == ref);
+            crt.pow(r, x, dp, dq, true);
+            CHECK(r == ref);
+            CHECK(crt.pow(x, key.dp(), key.dq()) == ref);
+            // Base hors de [0, n) : réduite avant UInt
+            crt.pow(r, x + key.n() * 3, dp, dq);
+            CHECK(r == ref);
+        }
+
+        mpz_class m1 = rng.get_z_range(key.p()), m2 = rng.get_z_range(key.q());
+        if (bits == 1024) {
+            UIntMontgomery<512> cp(uint_from_mpz<512>(key.p()));
+            UInt<1024> m = uint_crt(uint_from_mpz<512>(m1), uint_from_mpz<512>(m2),
+                                    uint_from_mpz<512>(key.q()), uint_from_mpz<512>(key.qinv()), cp);
+            mpz_class got = uint_to_mpz(m);
+            CHECK(got % key.p() == m1);
+            CHECK(got % key.q() == m2);
+            CHECK(got < key.n());
+        }
+    }
+}